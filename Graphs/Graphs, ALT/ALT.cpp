@@ -0,0 +1,238 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../heap/heap.h"
+
+class LandmarkTable {
+  std::vector<int> owned_;
+  void* map_ = nullptr;
+  size_t map_size_ = 0;
+  const int* dist_ = nullptr;
+  int size_ = 0;
+  int count_ = 0;
+
+  static constexpr int kMagic = 0x31544c41;
+
+ public:
+  LandmarkTable() = default;
+  LandmarkTable(const LandmarkTable&) = delete;
+  LandmarkTable& operator=(const LandmarkTable&) = delete;
+  ~LandmarkTable() {
+    if (map_ != nullptr) {
+      munmap(map_, map_size_);
+    }
+  }
+  void Assign(int n, int k, std::vector<int> dist) {
+    owned_ = std::move(dist);
+    dist_ = owned_.data();
+    size_ = n;
+    count_ = k;
+  }
+  bool Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    int header[3] = {kMagic, size_, count_};
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(dist_), sizeof(int) * size_ * count_);
+    return static_cast<bool>(out);
+  }
+  bool Map(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) == -1 || st.st_size < static_cast<off_t>(3 * sizeof(int))) {
+      close(fd);
+      return false;
+    }
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    const int* header = static_cast<const int*>(map);
+    size_t expected = sizeof(int) * (3 + static_cast<size_t>(header[1]) * header[2]);
+    if (header[0] != kMagic || header[1] < 0 || header[2] < 0 || static_cast<size_t>(st.st_size) != expected) {
+      munmap(map, st.st_size);
+      return false;
+    }
+    map_ = map;
+    map_size_ = st.st_size;
+    size_ = header[1];
+    count_ = header[2];
+    dist_ = header + 3;
+    return true;
+  }
+  int Size() const {
+    return size_;
+  }
+  int Count() const {
+    return count_;
+  }
+  const int* Row(int v) const {
+    return dist_ + static_cast<size_t>(v) * count_;
+  }
+};
+
+class Graph {
+  std::vector<std::vector<std::pair<int, int>>> graph_;
+  std::vector<int> dist_;
+  std::vector<unsigned> seen_;
+  Heap<int64_t> heap_;
+  unsigned epoch_ = 0;
+  int settled_ = 0;
+  int inf_ = 2009000999;
+
+  void NextEpoch() {
+    if (++epoch_ == 0) {
+      std::fill(seen_.begin(), seen_.end(), 0);
+      epoch_ = 1;
+    }
+    heap_.Clear();
+    settled_ = 0;
+  }
+
+ public:
+  explicit Graph(int n) : graph_(n), dist_(n), seen_(n, 0), heap_(n) {
+  }
+  void AddEdge(int start, int finish, int weight) {
+    graph_[start].emplace_back(weight, finish);
+    graph_[finish].emplace_back(weight, start);
+  }
+  int Size() const {
+    return static_cast<int>(graph_.size());
+  }
+  std::vector<int> Dijkstra(int start) {
+    std::vector<int> dist(graph_.size(), inf_);
+    dist[start] = 0;
+    Heap<int> heap(static_cast<int>(graph_.size()));
+    heap.Add(start, 0);
+    while (!heap.Empty()) {
+      auto [d, v] = heap.ExtractMin();
+      for (auto [w, u] : graph_[v]) {
+        if (d + w < dist[u]) {
+          if (dist[u] == inf_) {
+            heap.Add(u, d + w);
+          } else {
+            heap.DecreaseKey(u, d + w);
+          }
+          dist[u] = d + w;
+        }
+      }
+    }
+    return dist;
+  }
+  void Landmarks(int k, LandmarkTable& table) {
+    int n = Size();
+    k = std::min(k, n);
+    std::vector<int> dist(static_cast<size_t>(n) * k, inf_);
+    std::vector<int> nearest(n, inf_);
+    int next = 0;
+    for (int i = 0; i < k; ++i) {
+      auto from = Dijkstra(next);
+      for (int v = 0; v < n; ++v) {
+        dist[static_cast<size_t>(v) * k + i] = from[v];
+        nearest[v] = std::min(nearest[v], from[v]);
+      }
+      nearest[next] = 0;
+      next = static_cast<int>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+    }
+    table.Assign(n, k, std::move(dist));
+  }
+  int64_t Bound(const LandmarkTable& table, int v, int finish) const {
+    const int* from_v = table.Row(v);
+    const int* from_t = table.Row(finish);
+    int64_t bound = 0;
+    for (int i = 0; i < table.Count(); ++i) {
+      if ((from_v[i] == inf_) != (from_t[i] == inf_)) {
+        return inf_;
+      }
+      if (from_v[i] != inf_) {
+        bound = std::max<int64_t>(bound, std::abs(static_cast<int64_t>(from_t[i]) - from_v[i]));
+      }
+    }
+    return bound;
+  }
+  int AStar(const LandmarkTable& table, int start, int finish) {
+    NextEpoch();
+    seen_[start] = epoch_;
+    dist_[start] = 0;
+    heap_.Add(start, Bound(table, start, finish));
+    while (!heap_.Empty()) {
+      auto [key, v] = heap_.ExtractMin();
+      if (key >= inf_) {
+        break;
+      }
+      ++settled_;
+      if (v == finish) {
+        return dist_[v];
+      }
+      for (auto [w, u] : graph_[v]) {
+        int d = dist_[v] + w;
+        if (seen_[u] != epoch_) {
+          seen_[u] = epoch_;
+          dist_[u] = d;
+          heap_.Add(u, d + Bound(table, u, finish));
+        } else if (heap_.Contains(u) && d < dist_[u]) {
+          dist_[u] = d;
+          heap_.DecreaseKey(u, d + Bound(table, u, finish));
+        }
+      }
+    }
+    return inf_;
+  }
+  int Settled() const {
+    return settled_;
+  }
+};
+
+int main(int argc, char* argv[]) {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+  std::cout.tie(nullptr);
+  std::string mode = argc > 1 ? argv[1] : "";
+  int n = 0;
+  int m = 0;
+  int s = 0;
+  int f = 0;
+  int w = 0;
+  std::cin >> n >> m;
+  Graph graph(n);
+  for (int j = 0; j < m; ++j) {
+    std::cin >> s >> f >> w;
+    graph.AddEdge(s, f, w);
+  }
+  LandmarkTable table;
+  if (mode == "build" && argc > 2) {
+    graph.Landmarks(argc > 3 ? std::stoi(argv[3]) : 16, table);
+    if (!table.Save(argv[2])) {
+      std::cerr << "cannot write " << argv[2] << '\n';
+      return 1;
+    }
+    return 0;
+  }
+  if (mode == "query" && argc > 2) {
+    if (!table.Map(argv[2]) || table.Size() != n) {
+      std::cerr << "cannot map " << argv[2] << '\n';
+      return 1;
+    }
+  } else {
+    graph.Landmarks(16, table);
+  }
+  int q = 0;
+  std::cin >> q;
+  for (int i = 0; i < q; ++i) {
+    std::cin >> s >> f;
+    std::cout << graph.AStar(table, s, f) << '\n';
+  }
+  return 0;
+}
@@ -1,6 +1,15 @@
 #include <vector>
 #include <iostream>
 #include <queue>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
 
 struct Edge {
   int u = 0;
@@ -11,77 +20,495 @@ struct Edge {
   }
 };
 
+struct Cut {
+  std::vector<bool> source_side;
+  std::vector<int> edges;
+};
+
+class ActivePool {
+  std::vector<std::deque<int>> queues_;
+  std::vector<std::mutex> locks_;
+  std::atomic<int64_t> pending_{0};
+
+ public:
+  explicit ActivePool(int threads) : queues_(threads), locks_(threads) {
+  }
+  void Push(int id, int v) {
+    pending_.fetch_add(1);
+    std::lock_guard<std::mutex> guard(locks_[id]);
+    queues_[id].push_back(v);
+  }
+  bool Pop(int id, int& v) {
+    int threads = static_cast<int>(queues_.size());
+    for (int i = 0; i < threads; ++i) {
+      int victim = (id + i) % threads;
+      std::lock_guard<std::mutex> guard(locks_[victim]);
+      if (queues_[victim].empty()) {
+        continue;
+      }
+      if (victim == id) {
+        v = queues_[victim].back();
+        queues_[victim].pop_back();
+      } else {
+        v = queues_[victim].front();
+        queues_[victim].pop_front();
+      }
+      return true;
+    }
+    return false;
+  }
+  void Done() {
+    pending_.fetch_sub(1);
+  }
+  bool Finished() const {
+    return pending_.load() == 0;
+  }
+};
+
 class Graph {
   std::vector<std::vector<Edge>> graph_;
+  std::vector<std::pair<int, size_t>> edges_;
+  std::vector<int64_t> excess_;
+  std::vector<int> height_;
+  std::vector<int> count_;
+  std::vector<size_t> arc_;
+  std::vector<std::vector<int>> active_;
+  int highest_ = -1;
+  int relabels_ = 0;
+  std::vector<unsigned> mark_;
+  std::vector<Edge*> parent_;
+  std::vector<int> queue_;
+  unsigned epoch_ = 0;
   int size_;
 
- public:
-  explicit Graph(int n) : graph_(n + 1), size_(n) {
+  void Activate(int v) {
+    if (v != 1 && v != size_ && height_[v] < size_) {
+      active_[height_[v]].push_back(v);
+      highest_ = std::max(highest_, height_[v]);
+    }
   }
-  void AddEdge(int v, int u, int c) {
-    graph_[v].emplace_back(Edge(u, c));
-    graph_[u].emplace_back(Edge(v, 0));
-    graph_[v].back().back = graph_[u].size() - 1;
-    graph_[u].back().back = graph_[v].size() - 1;
-  }
-  std::vector<Edge*> BFS(int start, int finish, int& cmin) {
-    int inf = static_cast<int>(graph_.size());
-    std::vector<std::pair<int, Edge*>> parent(graph_.size());
-    parent[start].first = start;
-    std::vector<int> dist(graph_.size(), inf);
-    dist[start] = 0;
+  void Push(int v, Edge& edge) {
+    int delta = static_cast<int>(std::min<int64_t>(excess_[v], edge.c - edge.f));
+    edge.f += delta;
+    graph_[edge.u][edge.back].f -= delta;
+    if (excess_[edge.u] == 0) {
+      Activate(edge.u);
+    }
+    excess_[v] -= delta;
+    excess_[edge.u] += delta;
+  }
+  void Gap(int h) {
+    for (int v = 1; v <= size_; ++v) {
+      if (height_[v] > h && height_[v] < size_) {
+        --count_[height_[v]];
+        height_[v] = size_;
+      }
+    }
+  }
+  void Relabel(int v) {
+    int old = height_[v];
+    int h = size_;
+    for (auto& edge : graph_[v]) {
+      if (edge.f < edge.c) {
+        h = std::min(h, height_[edge.u] + 1);
+      }
+    }
+    --count_[old];
+    if (count_[old] == 0) {
+      Gap(old);
+      h = size_;
+    }
+    height_[v] = h;
+    if (h < size_) {
+      ++count_[h];
+    }
+    arc_[v] = 0;
+    ++relabels_;
+  }
+  void GlobalRelabel() {
+    std::fill(height_.begin(), height_.end(), size_);
+    std::fill(count_.begin(), count_.end(), 0);
+    for (auto& bucket : active_) {
+      bucket.clear();
+    }
+    highest_ = -1;
+    height_[size_] = 0;
     std::queue<int> queue;
-    queue.push(start);
+    queue.push(size_);
     while (!queue.empty()) {
       int v = queue.front();
       queue.pop();
+      ++count_[height_[v]];
       for (auto& edge : graph_[v]) {
-        int u = edge.u;
-        if (edge.f < edge.c && dist[u] == inf) {
-          dist[u] = dist[v] + 1;
-          parent[u].first = v;
-          parent[u].second = &edge;
-          queue.push(u);
+        auto& rev = graph_[edge.u][edge.back];
+        if (rev.f < rev.c && height_[edge.u] == size_ && edge.u != 1) {
+          height_[edge.u] = height_[v] + 1;
+          queue.push(edge.u);
         }
       }
     }
-    if (dist[finish] == inf) {
-      return {};
+    height_[1] = size_;
+    for (int v = 1; v <= size_; ++v) {
+      arc_[v] = 0;
+      if (excess_[v] > 0) {
+        Activate(v);
+      }
     }
-    std::vector<Edge*> path(dist[finish]);
-    int i = dist[finish] - 1;
-    int cur_vert = finish;
-    Edge* cur_edge = parent[finish].second;
-    while (cur_vert != start) {
-      if (cmin > (*cur_edge).c - (*cur_edge).f) {
-        cmin = (*cur_edge).c - (*cur_edge).f;
+    relabels_ = 0;
+  }
+  void Discharge(int v) {
+    while (excess_[v] > 0) {
+      if (arc_[v] == graph_[v].size()) {
+        Relabel(v);
+        if (height_[v] >= size_) {
+          return;
+        }
+        continue;
+      }
+      auto& edge = graph_[v][arc_[v]];
+      if (edge.f < edge.c && height_[v] == height_[edge.u] + 1) {
+        Push(v, edge);
+      } else {
+        ++arc_[v];
       }
-      path[i] = cur_edge;
-      cur_vert = parent[cur_vert].first;
-      cur_edge = parent[cur_vert].second;
-      --i;
     }
-    return path;
+  }
+
+ public:
+  explicit Graph(int n) : graph_(n + 1), mark_(n + 1), parent_(n + 1), queue_(n + 1), size_(n) {
+  }
+  void AddEdge(int v, int u, int c) {
+    size_t i = graph_[v].size();
+    size_t j = graph_[u].size() + (v == u ? 1 : 0);
+    edges_.emplace_back(v, i);
+    graph_[v].emplace_back(Edge(u, c));
+    graph_[u].emplace_back(Edge(v, 0));
+    graph_[v][i].back = j;
+    graph_[u][j].back = i;
+  }
+  int BFS(int start, int finish) {
+    if (++epoch_ == 0) {
+      std::fill(mark_.begin(), mark_.end(), 0);
+      epoch_ = 1;
+    }
+    mark_[start] = epoch_;
+    size_t head = 0;
+    size_t tail = 0;
+    queue_[tail++] = start;
+    while (head != tail && mark_[finish] != epoch_) {
+      int v = queue_[head++];
+      for (auto& edge : graph_[v]) {
+        int u = edge.u;
+        if (edge.f < edge.c && mark_[u] != epoch_) {
+          mark_[u] = epoch_;
+          parent_[u] = &edge;
+          queue_[tail++] = u;
+          if (u == finish) {
+            break;
+          }
+        }
+      }
+    }
+    if (mark_[finish] != epoch_ || start == finish) {
+      return 0;
+    }
+    int cmin = 1'000'000'000;
+    for (int v = finish; v != start;) {
+      Edge* edge = parent_[v];
+      cmin = std::min(cmin, edge->c - edge->f);
+      v = graph_[v][edge->back].u;
+    }
+    for (int v = finish; v != start;) {
+      Edge* edge = parent_[v];
+      auto& rev = graph_[v][edge->back];
+      edge->f += cmin;
+      rev.f -= cmin;
+      v = rev.u;
+    }
+    return cmin;
   }
   int EK() {
     int flow = 0;
-    while (true) {
-      int cmin = 1'000'000'000;
-      auto path = BFS(1, size_, cmin);
-      if (path.empty()) {
-        return flow;
+    while (int cmin = BFS(1, size_)) {
+      flow += cmin;
+    }
+    return flow;
+  }
+  Cut MinCut() {
+    Cut cut;
+    cut.source_side.assign(size_ + 1, true);
+    cut.source_side[0] = false;
+    cut.source_side[size_] = false;
+    std::vector<int> queue = {size_};
+    for (size_t i = 0; i < queue.size(); ++i) {
+      int v = queue[i];
+      for (auto& edge : graph_[v]) {
+        auto& rev = graph_[edge.u][edge.back];
+        if (rev.f < rev.c && cut.source_side[edge.u]) {
+          cut.source_side[edge.u] = false;
+          queue.push_back(edge.u);
+        }
       }
-      for (auto& edge : path) {
-        edge->f += cmin;
-        graph_[edge->u][edge->back].f -= cmin;
+    }
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      auto [v, idx] = edges_[i];
+      if (cut.source_side[v] && !cut.source_side[graph_[v][idx].u]) {
+        cut.edges.push_back(static_cast<int>(i));
       }
-      flow += cmin;
+    }
+    return cut;
+  }
+  std::vector<int> Snapshot() const {
+    std::vector<int> flows(edges_.size());
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      flows[i] = graph_[edges_[i].first][edges_[i].second].f;
+    }
+    return flows;
+  }
+  void Restore(const std::vector<int>& flows) {
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      auto& edge = graph_[edges_[i].first][edges_[i].second];
+      edge.f = flows[i];
+      graph_[edge.u][edge.back].f = -flows[i];
+    }
+  }
+  int FlowValue() const {
+    int flow = 0;
+    for (auto& edge : graph_[1]) {
+      flow += edge.f;
     }
     return flow;
   }
+  int64_t PushRelabel() {
+    excess_.assign(size_ + 1, 0);
+    height_.assign(size_ + 1, 0);
+    count_.assign(size_ + 1, 0);
+    arc_.assign(size_ + 1, 0);
+    active_.assign(size_, {});
+    if (size_ == 1) {
+      return 0;
+    }
+    for (int v = 2; v <= size_; ++v) {
+      for (auto& edge : graph_[v]) {
+        excess_[v] -= edge.f;
+      }
+    }
+    int64_t initial = excess_[size_];
+    for (auto& edge : graph_[1]) {
+      if (edge.f < edge.c) {
+        excess_[1] += edge.c - edge.f;
+        Push(1, edge);
+      }
+    }
+    GlobalRelabel();
+    while (highest_ >= 0) {
+      if (active_[highest_].empty()) {
+        --highest_;
+        continue;
+      }
+      int v = active_[highest_].back();
+      active_[highest_].pop_back();
+      if (height_[v] != highest_ || excess_[v] == 0) {
+        continue;
+      }
+      Discharge(v);
+      if (relabels_ >= size_) {
+        GlobalRelabel();
+      }
+    }
+    return excess_[size_] - initial;
+  }
+  int64_t ParallelPushRelabel(int threads) {
+    if (size_ == 1) {
+      return 0;
+    }
+    std::vector<size_t> offset(size_ + 2, 0);
+    for (int v = 1; v <= size_; ++v) {
+      offset[v + 1] = offset[v] + graph_[v].size();
+    }
+    size_t arcs = offset[size_ + 1];
+    std::unique_ptr<std::atomic<int>[]> flow(new std::atomic<int>[arcs]);
+    std::unique_ptr<std::atomic<int64_t>[]> excess(new std::atomic<int64_t>[size_ + 1]);
+    std::unique_ptr<std::atomic<int>[]> height(new std::atomic<int>[size_ + 1]);
+    std::unique_ptr<std::atomic<bool>[]> queued(new std::atomic<bool>[size_ + 1]);
+    for (int v = 1; v <= size_; ++v) {
+      int64_t inflow = 0;
+      for (size_t i = 0; i < graph_[v].size(); ++i) {
+        flow[offset[v] + i].store(graph_[v][i].f);
+        inflow -= graph_[v][i].f;
+      }
+      excess[v].store(v == 1 ? 0 : inflow);
+      height[v].store(size_);
+      queued[v].store(false);
+    }
+    int64_t initial = excess[size_].load();
+    for (size_t i = 0; i < graph_[1].size(); ++i) {
+      auto& edge = graph_[1][i];
+      int delta = edge.c - flow[offset[1] + i].load();
+      if (delta > 0) {
+        flow[offset[1] + i].fetch_add(delta);
+        flow[offset[edge.u] + edge.back].fetch_sub(delta);
+        excess[edge.u].fetch_add(delta);
+      }
+    }
+    std::atomic<int> relabels{0};
+    auto relabel = [&](int root, int base) {
+      std::vector<int> queue = {root};
+      height[root].store(base);
+      for (size_t i = 0; i < queue.size(); ++i) {
+        int v = queue[i];
+        for (size_t j = 0; j < graph_[v].size(); ++j) {
+          auto& edge = graph_[v][j];
+          size_t rev = offset[edge.u] + edge.back;
+          if (flow[rev].load() < graph_[edge.u][edge.back].c && height[edge.u].load() == 2 * size_) {
+            height[edge.u].store(height[v].load() + 1);
+            queue.push_back(edge.u);
+          }
+        }
+      }
+    };
+    auto discharge = [&](ActivePool& pool, int id, int v) {
+      int64_t e = 0;
+      while ((e = excess[v].load()) > 0) {
+        size_t best = arcs;
+        int lowest = 0;
+        for (size_t i = 0; i < graph_[v].size(); ++i) {
+          int h = height[graph_[v][i].u].load();
+          if (flow[offset[v] + i].load() < graph_[v][i].c && (best == arcs || h < lowest)) {
+            best = i;
+            lowest = h;
+          }
+        }
+        if (best == arcs) {
+          return;
+        }
+        if (height[v].load() > lowest) {
+          auto& edge = graph_[v][best];
+          int delta = static_cast<int>(std::min<int64_t>(e, edge.c - flow[offset[v] + best].load()));
+          flow[offset[v] + best].fetch_add(delta);
+          flow[offset[edge.u] + edge.back].fetch_sub(delta);
+          excess[v].fetch_sub(delta);
+          excess[edge.u].fetch_add(delta);
+          if (edge.u != 1 && edge.u != size_ && !queued[edge.u].exchange(true)) {
+            pool.Push(id, edge.u);
+          }
+        } else {
+          height[v].store(lowest + 1);
+          relabels.fetch_add(1);
+        }
+      }
+    };
+    while (true) {
+      for (int v = 1; v <= size_; ++v) {
+        height[v].store(2 * size_);
+        queued[v].store(false);
+      }
+      height[1].store(size_);
+      relabel(size_, 0);
+      height[1].store(2 * size_);
+      relabel(1, size_);
+      ActivePool pool(threads);
+      for (int v = 2; v < size_; ++v) {
+        if (excess[v].load() > 0 && !queued[v].exchange(true)) {
+          pool.Push(v % threads, v);
+        }
+      }
+      if (pool.Finished()) {
+        break;
+      }
+      relabels.store(0);
+      auto worker = [&](int id) {
+        int v = 0;
+        while (!pool.Finished() && relabels.load() < size_) {
+          if (!pool.Pop(id, v)) {
+            std::this_thread::yield();
+            continue;
+          }
+          discharge(pool, id, v);
+          queued[v].store(false);
+          if (excess[v].load() > 0 && !queued[v].exchange(true)) {
+            pool.Push(id, v);
+          }
+          pool.Done();
+        }
+      };
+      std::vector<std::thread> workers;
+      for (int id = 1; id < threads; ++id) {
+        workers.emplace_back(worker, id);
+      }
+      worker(0);
+      for (auto& thread : workers) {
+        thread.join();
+      }
+    }
+    for (int v = 1; v <= size_; ++v) {
+      for (size_t i = 0; i < graph_[v].size(); ++i) {
+        graph_[v][i].f = flow[offset[v] + i].load();
+      }
+    }
+    return excess[size_].load() - initial;
+  }
 };
 
-int main() {
+void Benchmark(int n, int m, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> vertex(1, n);
+  std::uniform_int_distribution<int> capacity(1, 1000);
+  Graph graph(n);
+  for (int i = 0; i < m; ++i) {
+    graph.AddEdge(vertex(gen), vertex(gen), capacity(gen));
+  }
+  Graph copy = graph;
+  auto t0 = std::chrono::steady_clock::now();
+  int64_t ek = graph.EK();
+  auto t1 = std::chrono::steady_clock::now();
+  int64_t pr = copy.PushRelabel();
+  auto t2 = std::chrono::steady_clock::now();
+  std::cout << "n=" << n << " m=" << m << '\n';
+  std::cout << "EK:           " << ek << ' '
+            << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+  std::cout << "PushRelabel:  " << pr << ' '
+            << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms\n";
+}
+
+void ScalingBenchmark(int n, int m, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> vertex(1, n);
+  std::uniform_int_distribution<int> capacity(1, 1000);
+  Graph graph(n);
+  for (int i = 0; i < m; ++i) {
+    graph.AddEdge(vertex(gen), vertex(gen), capacity(gen));
+  }
+  Graph copy = graph;
+  auto t0 = std::chrono::steady_clock::now();
+  int64_t pr = copy.PushRelabel();
+  auto t1 = std::chrono::steady_clock::now();
+  std::cout << "n=" << n << " m=" << m << '\n';
+  std::cout << "PushRelabel:       " << pr << ' '
+            << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    copy = graph;
+    t0 = std::chrono::steady_clock::now();
+    int64_t flow = copy.ParallelPushRelabel(threads);
+    t1 = std::chrono::steady_clock::now();
+    std::cout << "Parallel x" << threads << (threads < 10 ? ":       " : ":      ") << flow << ' '
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "bench-parallel") {
+    int n = argc > 2 ? std::stoi(argv[2]) : 10'000;
+    int m = argc > 3 ? std::stoi(argv[3]) : 1'000'000;
+    ScalingBenchmark(n, m, argc > 4 ? std::stoi(argv[4]) : 1);
+    return 0;
+  }
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    int n = argc > 2 ? std::stoi(argv[2]) : 10'000;
+    int m = argc > 3 ? std::stoi(argv[3]) : 1'000'000;
+    Benchmark(n, m, argc > 4 ? std::stoi(argv[4]) : 1);
+    return 0;
+  }
   std::ios::sync_with_stdio(false);
   std::cin.tie(nullptr);
   std::cout.tie(nullptr);
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <queue>
+#include <string>
+#include <utility>
 #include <vector>
 
 class UnorientedGraph {
@@ -26,27 +29,191 @@ class UnorientedGraph {
   void AddEdge(int start, int finish) {
     graph_[start].emplace_back(finish);
   }
+  std::vector<int> Sides() {
+    std::vector<int> mark(graph_.size(), 0);
+    for (size_t i = 1; i < graph_.size(); ++i) {
+      if (mark[i] == 0) {
+        mark[i] = 1;
+      }
+      if (!IsBipartite(mark, i)) {
+        return {};
+      }
+    }
+    return mark;
+  }
   bool IsBipartite() {
     if (graph_.empty()) {
       return true;
     }
-    std::vector<int> mark(graph_.size());
-    for (size_t i = 0; i < mark.size(); ++i) {
-      mark[i] = 0;
+    return !Sides().empty();
+  }
+  const std::vector<int>& Neighbours(size_t v) const {
+    return graph_[v];
+  }
+};
+
+class HopcroftKarp {
+  std::vector<int> offset_;
+  std::vector<int> adj_;
+  std::vector<int> match_left_;
+  std::vector<int> match_right_;
+  std::vector<int> dist_;
+  std::vector<int> arc_;
+  int free_dist_ = -1;
+  int left_;
+  int right_;
+
+  bool BFS() {
+    std::queue<int> queue;
+    free_dist_ = -1;
+    for (int v = 0; v < left_; ++v) {
+      dist_[v] = match_left_[v] == -1 ? 0 : -1;
+      if (dist_[v] == 0) {
+        queue.push(v);
+      }
     }
-    for (size_t i = 1; i < graph_.size(); ++i) {
-      if (mark[i] == 0) {
-        mark[i] = 1;
+    while (!queue.empty()) {
+      int v = queue.front();
+      queue.pop();
+      if (free_dist_ != -1 && dist_[v] >= free_dist_) {
+        continue;
       }
-      if (!IsBipartite(mark, i)) {
-        return false;
+      for (int i = offset_[v]; i < offset_[v + 1]; ++i) {
+        int w = match_right_[adj_[i]];
+        if (w == -1) {
+          free_dist_ = dist_[v] + 1;
+        } else if (dist_[w] == -1) {
+          dist_[w] = dist_[v] + 1;
+          queue.push(w);
+        }
       }
     }
-    return true;
+    return free_dist_ != -1;
+  }
+  bool DFS(int v) {
+    for (int& i = arc_[v]; i < offset_[v + 1]; ++i) {
+      int u = adj_[i];
+      int w = match_right_[u];
+      if ((w == -1 && free_dist_ == dist_[v] + 1) || (w != -1 && dist_[w] == dist_[v] + 1 && DFS(w))) {
+        match_left_[v] = u;
+        match_right_[u] = v;
+        return true;
+      }
+    }
+    dist_[v] = -1;
+    return false;
+  }
+
+ public:
+  HopcroftKarp(int left, int right, std::vector<int> offset, std::vector<int> adj)
+      : offset_(std::move(offset)),
+        adj_(std::move(adj)),
+        match_left_(left, -1),
+        match_right_(right, -1),
+        dist_(left),
+        arc_(left),
+        left_(left),
+        right_(right) {
+  }
+  int MaxMatching() {
+    int matching = 0;
+    while (BFS()) {
+      for (int v = 0; v < left_; ++v) {
+        arc_[v] = offset_[v];
+      }
+      for (int v = 0; v < left_; ++v) {
+        if (match_left_[v] == -1 && DFS(v)) {
+          ++matching;
+        }
+      }
+    }
+    return matching;
+  }
+  const std::vector<int>& MatchLeft() const {
+    return match_left_;
+  }
+  std::pair<std::vector<int>, std::vector<int>> VertexCover() {
+    std::vector<bool> left_seen(left_, false);
+    std::vector<bool> right_seen(right_, false);
+    std::queue<int> queue;
+    for (int v = 0; v < left_; ++v) {
+      if (match_left_[v] == -1) {
+        left_seen[v] = true;
+        queue.push(v);
+      }
+    }
+    while (!queue.empty()) {
+      int v = queue.front();
+      queue.pop();
+      for (int i = offset_[v]; i < offset_[v + 1]; ++i) {
+        int u = adj_[i];
+        if (!right_seen[u] && match_left_[v] != u) {
+          right_seen[u] = true;
+          int w = match_right_[u];
+          if (w != -1 && !left_seen[w]) {
+            left_seen[w] = true;
+            queue.push(w);
+          }
+        }
+      }
+    }
+    std::pair<std::vector<int>, std::vector<int>> cover;
+    for (int v = 0; v < left_; ++v) {
+      if (!left_seen[v]) {
+        cover.first.push_back(v);
+      }
+    }
+    for (int u = 0; u < right_; ++u) {
+      if (right_seen[u]) {
+        cover.second.push_back(u);
+      }
+    }
+    return cover;
   }
 };
 
-int main() {
+void Matching(UnorientedGraph& graph, size_t n) {
+  auto sides = graph.Sides();
+  if (sides.empty()) {
+    std::cout << "NO";
+    return;
+  }
+  std::vector<int> index(n + 1);
+  std::vector<int> left;
+  std::vector<int> right;
+  for (size_t v = 1; v <= n; ++v) {
+    auto& side = sides[v] == 1 ? left : right;
+    index[v] = static_cast<int>(side.size());
+    side.push_back(static_cast<int>(v));
+  }
+  std::vector<int> offset(left.size() + 1, 0);
+  std::vector<int> adj;
+  for (size_t i = 0; i < left.size(); ++i) {
+    for (auto u : graph.Neighbours(left[i])) {
+      adj.push_back(index[u]);
+    }
+    offset[i + 1] = static_cast<int>(adj.size());
+  }
+  HopcroftKarp matcher(static_cast<int>(left.size()), static_cast<int>(right.size()), offset, adj);
+  std::cout << matcher.MaxMatching() << '\n';
+  auto& match = matcher.MatchLeft();
+  for (size_t i = 0; i < left.size(); ++i) {
+    if (match[i] != -1) {
+      std::cout << left[i] << ' ' << right[match[i]] << '\n';
+    }
+  }
+  auto [cover_left, cover_right] = matcher.VertexCover();
+  std::cout << cover_left.size() + cover_right.size() << '\n';
+  for (auto v : cover_left) {
+    std::cout << left[v] << ' ';
+  }
+  for (auto u : cover_right) {
+    std::cout << right[u] << ' ';
+  }
+  std::cout << '\n';
+}
+
+int main(int argc, char* argv[]) {
   size_t n, m;
   std::cin >> n >> m;
   UnorientedGraph graph(n);
@@ -56,6 +223,10 @@ int main() {
     graph.AddEdge(a, b);
     graph.AddEdge(b, a);
   }
+  if (argc > 1 && std::string(argv[1]) == "matching") {
+    Matching(graph, n);
+    return 0;
+  }
   std::cout << (graph.IsBipartite() ? "YES" : "NO");
   return 0;
 }
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../heap/heap.h"
+
+class ContractionHierarchy {
+  std::vector<std::vector<std::pair<int, int>>> graph_;
+  std::vector<std::vector<std::pair<int, int>>> up_;
+  std::vector<int> rank_;
+  std::vector<bool> contracted_;
+  std::vector<int> deleted_;
+  std::vector<int> target_;
+  std::vector<int> dist_;
+  std::vector<int> dist_back_;
+  std::vector<unsigned> seen_;
+  std::vector<unsigned> seen_back_;
+  Heap<int> heap_;
+  Heap<int> heap_back_;
+  unsigned epoch_ = 0;
+  int inf_ = 2009000999;
+
+  void NextEpoch() {
+    if (++epoch_ == 0) {
+      std::fill(seen_.begin(), seen_.end(), 0);
+      std::fill(seen_back_.begin(), seen_back_.end(), 0);
+      epoch_ = 1;
+    }
+    heap_.Clear();
+    heap_back_.Clear();
+  }
+  int Dist(int v) const {
+    return seen_[v] == epoch_ ? dist_[v] : inf_;
+  }
+  std::vector<std::pair<int, int>> Neighbours(int v) {
+    std::vector<std::pair<int, int>> result;
+    for (auto [w, u] : graph_[v]) {
+      if (!contracted_[u] && u != v) {
+        result.emplace_back(u, w);
+      }
+    }
+    std::sort(result.begin(), result.end());
+    size_t size = 0;
+    for (size_t i = 0; i < result.size(); ++i) {
+      if (size == 0 || result[size - 1].first != result[i].first) {
+        result[size++] = result[i];
+      }
+    }
+    result.resize(size);
+    return result;
+  }
+  void Witness(int source, int skip, int targets, int limit, int settle_limit) {
+    NextEpoch();
+    seen_[source] = epoch_;
+    dist_[source] = 0;
+    heap_.Add(source, 0);
+    int settled = 0;
+    while (!heap_.Empty() && settled < settle_limit && targets > 0) {
+      auto [d, v] = heap_.ExtractMin();
+      if (d > limit) {
+        break;
+      }
+      ++settled;
+      if (target_[v] == skip && v != source) {
+        --targets;
+      }
+      for (auto [w, u] : graph_[v]) {
+        if (u == skip || contracted_[u]) {
+          continue;
+        }
+        if (seen_[u] != epoch_) {
+          seen_[u] = epoch_;
+          dist_[u] = d + w;
+          heap_.Add(u, d + w);
+        } else if (heap_.Contains(u) && d + w < dist_[u]) {
+          dist_[u] = d + w;
+          heap_.DecreaseKey(u, d + w);
+        }
+      }
+    }
+  }
+  void AddShortcut(int v, int u, int w) {
+    for (auto& edge : graph_[v]) {
+      if (edge.second == u) {
+        if (w < edge.first) {
+          edge.first = w;
+          for (auto& rev : graph_[u]) {
+            if (rev.second == v) {
+              rev.first = std::min(rev.first, w);
+            }
+          }
+        }
+        return;
+      }
+    }
+    graph_[v].emplace_back(w, u);
+    graph_[u].emplace_back(w, v);
+  }
+  int Contract(int v, bool simulate) {
+    auto neighbours = Neighbours(v);
+    int max_w = 0;
+    for (auto [u, w] : neighbours) {
+      max_w = std::max(max_w, w);
+      target_[u] = v;
+    }
+    int shortcuts = 0;
+    for (size_t i = 0; i < neighbours.size(); ++i) {
+      auto [u, wu] = neighbours[i];
+      Witness(u, v, static_cast<int>(neighbours.size()) - 1, wu + max_w, simulate ? 50 : 500);
+      for (size_t j = i + 1; j < neighbours.size(); ++j) {
+        auto [x, wx] = neighbours[j];
+        if (Dist(x) > wu + wx) {
+          ++shortcuts;
+          if (!simulate) {
+            AddShortcut(u, x, wu + wx);
+          }
+        }
+      }
+    }
+    if (!simulate) {
+      for (auto [u, w] : neighbours) {
+        up_[v].emplace_back(w, u);
+        ++deleted_[u];
+        auto& edges = graph_[u];
+        edges.erase(std::remove_if(edges.begin(), edges.end(), [v](auto& edge) { return edge.second == v; }),
+                    edges.end());
+      }
+      contracted_[v] = true;
+      graph_[v].clear();
+    }
+    return shortcuts - static_cast<int>(neighbours.size()) + deleted_[v];
+  }
+  void Resize(int n) {
+    rank_.assign(n, 0);
+    up_.assign(n, {});
+    dist_.assign(n, 0);
+    dist_back_.assign(n, 0);
+    seen_.assign(n, 0);
+    seen_back_.assign(n, 0);
+    heap_ = Heap<int>(n);
+    heap_back_ = Heap<int>(n);
+  }
+
+ public:
+  ContractionHierarchy() : heap_(0), heap_back_(0) {
+  }
+  explicit ContractionHierarchy(int n) : graph_(n), heap_(n), heap_back_(n) {
+    Resize(n);
+  }
+  void AddEdge(int start, int finish, int weight) {
+    graph_[start].emplace_back(weight, finish);
+    graph_[finish].emplace_back(weight, start);
+  }
+  void Build() {
+    int n = static_cast<int>(graph_.size());
+    contracted_.assign(n, false);
+    deleted_.assign(n, 0);
+    target_.assign(n, -1);
+    std::vector<int> priority(n);
+    for (int v = 0; v < n; ++v) {
+      priority[v] = Contract(v, true);
+    }
+    int offset = n;
+    Heap<int> order(n);
+    for (int v = 0; v < n; ++v) {
+      order.Add(v, priority[v] + offset);
+    }
+    int next = 0;
+    while (!order.Empty()) {
+      auto [p, v] = order.ExtractMin();
+      int fresh = Contract(v, true) + offset;
+      if (!order.Empty() && fresh > order.MinKey()) {
+        order.Add(v, fresh);
+        continue;
+      }
+      Contract(v, false);
+      rank_[v] = next++;
+    }
+    graph_.clear();
+  }
+  int Query(int start, int finish) {
+    NextEpoch();
+    int best = start == finish ? 0 : inf_;
+    seen_[start] = epoch_;
+    dist_[start] = 0;
+    heap_.Add(start, 0);
+    seen_back_[finish] = epoch_;
+    dist_back_[finish] = 0;
+    heap_back_.Add(finish, 0);
+    while (true) {
+      bool forward = !heap_.Empty() && heap_.MinKey() < best;
+      bool backward = !heap_back_.Empty() && heap_back_.MinKey() < best;
+      if (!forward && !backward) {
+        break;
+      }
+      if (forward && (!backward || heap_.MinKey() <= heap_back_.MinKey())) {
+        auto [d, v] = heap_.ExtractMin();
+        if (seen_back_[v] == epoch_) {
+          best = std::min(best, d + dist_back_[v]);
+        }
+        for (auto [w, u] : up_[v]) {
+          if (seen_[u] != epoch_) {
+            seen_[u] = epoch_;
+            dist_[u] = d + w;
+            heap_.Add(u, d + w);
+          } else if (heap_.Contains(u) && d + w < dist_[u]) {
+            dist_[u] = d + w;
+            heap_.DecreaseKey(u, d + w);
+          }
+        }
+      } else {
+        auto [d, v] = heap_back_.ExtractMin();
+        if (seen_[v] == epoch_) {
+          best = std::min(best, d + dist_[v]);
+        }
+        for (auto [w, u] : up_[v]) {
+          if (seen_back_[u] != epoch_) {
+            seen_back_[u] = epoch_;
+            dist_back_[u] = d + w;
+            heap_back_.Add(u, d + w);
+          } else if (heap_back_.Contains(u) && d + w < dist_back_[u]) {
+            dist_back_[u] = d + w;
+            heap_back_.DecreaseKey(u, d + w);
+          }
+        }
+      }
+    }
+    return best;
+  }
+  bool Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    int n = static_cast<int>(up_.size());
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(rank_.data()), sizeof(int) * n);
+    for (auto& edges : up_) {
+      int size = static_cast<int>(edges.size());
+      out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      out.write(reinterpret_cast<const char*>(edges.data()), sizeof(edges[0]) * size);
+    }
+    return static_cast<bool>(out);
+  }
+  bool Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    int n = 0;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)) || n < 0) {
+      return false;
+    }
+    Resize(n);
+    in.read(reinterpret_cast<char*>(rank_.data()), sizeof(int) * n);
+    for (auto& edges : up_) {
+      int size = 0;
+      in.read(reinterpret_cast<char*>(&size), sizeof(size));
+      if (!in || size < 0) {
+        return false;
+      }
+      edges.resize(size);
+      in.read(reinterpret_cast<char*>(edges.data()), sizeof(edges[0]) * size);
+    }
+    return static_cast<bool>(in);
+  }
+};
+
+ContractionHierarchy ReadGraph() {
+  int n = 0;
+  int m = 0;
+  int s = 0;
+  int f = 0;
+  int w = 0;
+  std::cin >> n >> m;
+  ContractionHierarchy ch(n);
+  for (int j = 0; j < m; ++j) {
+    std::cin >> s >> f >> w;
+    ch.AddEdge(s, f, w);
+  }
+  ch.Build();
+  return ch;
+}
+
+void AnswerQueries(ContractionHierarchy& ch) {
+  int q = 0;
+  int s = 0;
+  int f = 0;
+  std::cin >> q;
+  for (int i = 0; i < q; ++i) {
+    std::cin >> s >> f;
+    std::cout << ch.Query(s, f) << '\n';
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+  std::cout.tie(nullptr);
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "build" && argc > 2) {
+    auto ch = ReadGraph();
+    if (!ch.Save(argv[2])) {
+      std::cerr << "cannot write " << argv[2] << '\n';
+      return 1;
+    }
+    return 0;
+  }
+  if (mode == "query" && argc > 2) {
+    ContractionHierarchy ch;
+    if (!ch.Load(argv[2])) {
+      std::cerr << "cannot read " << argv[2] << '\n';
+      return 1;
+    }
+    AnswerQueries(ch);
+    return 0;
+  }
+  auto ch = ReadGraph();
+  AnswerQueries(ch);
+  return 0;
+}
@@ -1,92 +1,80 @@
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
 
-class Heap {
-  int size_ = 0;
-  std::vector<std::pair<int, int>> heap_;
-  std::vector<int> map_;
-
-  public:
-  explicit Heap(int max_size) : heap_(max_size), map_(max_size, -1) {
-  }
-  int Parent(int i) {
-    return (i - 1) / 2;
-  }
-  int LeftChild(int i) {
-    return i * 2 + 1;
-  }
-  int RightChild(int i) {
-    return i * 2 + 2;
-  }
-  int SiftUp(int i) {
-    int parent = Parent(i);
-    if (i > 0 && heap_[parent].first > heap_[i].first) {
-      std::swap(heap_[parent], heap_[i]);
-      std::swap(map_[heap_[parent].second], map_[heap_[i].second]);
-      i = SiftUp(parent);
-    }
-    return i;
-  }
-  void Add(int x, int w) {
-    heap_[size_++].first = w;
-    heap_[size_ - 1].second = x;
-    map_[x] = size_ - 1;
-    SiftUp(size_ - 1);
-  }
-  int SiftDown(int i) {
-    int left = LeftChild(i);
-    int right = RightChild(i);
-    int largest = i;
-    if (left < size_ && heap_[left].first < heap_[largest].first) {
-      largest = left;
-    }
-    if (right < size_ && heap_[right].first < heap_[largest].first) {
-      largest = right;
-    }
-    if (largest != i) {
-      std::swap(heap_[largest], heap_[i]);
-      std::swap(map_[heap_[largest].second], map_[heap_[i].second]);
-      i = SiftDown(largest);
-    }
-    return i;
-  }
-  std::pair<int, int> ExtractMin() {
-    if (size_ > 1) {
-      auto val = heap_[0];
-      --size_;
-      std::swap(heap_[0], heap_[size_]);
-      std::swap(map_[heap_[0].second], map_[heap_[size_].second]);
-      SiftDown(0);
-      return val;
-    }
-    --size_;
-    return heap_[0];
-  }
-  void DecreaseKey(int x, int new_w) {
-    int i = map_[x];
-    heap_[i].first = new_w;
-    SiftUp(i);
-  }
-  bool Empty() {
-    return size_ == 0;
-  }
-  bool Contains(int i) {
-    return map_[i] < size_;
-  }
-};
+#include "../heap/heap.h"
 
 class Graph {
   std::vector<std::vector<std::pair<int, int>>> graph_;
+  std::vector<std::vector<std::pair<int, int>>> reverse_;
+  std::vector<int> dist_;
+  std::vector<int> prev_;
+  std::vector<unsigned> seen_;
+  std::vector<int> dist_back_;
+  std::vector<int> next_;
+  std::vector<unsigned> seen_back_;
+  Heap<int> heap_;
+  Heap<int> heap_back_;
+  unsigned epoch_ = 0;
+  int meet_ = -1;
+  int settled_ = 0;
   int max_weight_ = 0;
 
+  void NextEpoch() {
+    if (++epoch_ == 0) {
+      std::fill(seen_.begin(), seen_.end(), 0);
+      std::fill(seen_back_.begin(), seen_back_.end(), 0);
+      epoch_ = 1;
+    }
+    heap_.Clear();
+    heap_back_.Clear();
+    meet_ = -1;
+    settled_ = 0;
+  }
+  void Scan(int v, int d, const std::vector<std::vector<std::pair<int, int>>>& graph, std::vector<int>& dist,
+            std::vector<int>& prev, std::vector<unsigned>& seen, Heap<int>& heap,
+            const std::vector<int>& other_dist, const std::vector<unsigned>& other_seen, int& best) {
+    ++settled_;
+    for (auto [w, u] : graph[v]) {
+      if (seen[u] != epoch_) {
+        seen[u] = epoch_;
+        dist[u] = d + w;
+        prev[u] = v;
+        heap.Add(u, d + w);
+      } else if (heap.Contains(u) && d + w < dist[u]) {
+        dist[u] = d + w;
+        prev[u] = v;
+        heap.DecreaseKey(u, d + w);
+      }
+      if (other_seen[u] == epoch_ && dist[u] + other_dist[u] < best) {
+        best = dist[u] + other_dist[u];
+        meet_ = u;
+      }
+    }
+  }
+
  public:
-  explicit Graph(int n) : graph_(n) {
+  explicit Graph(int n)
+      : graph_(n),
+        reverse_(n),
+        dist_(n),
+        prev_(n),
+        seen_(n, 0),
+        dist_back_(n),
+        next_(n),
+        seen_back_(n, 0),
+        heap_(n),
+        heap_back_(n) {
   }
   void AddEdge(int start, int finish, int weight) {
     if (weight > max_weight_) {
       max_weight_ = weight;
     }
     graph_[start].emplace_back(weight, finish);
+    reverse_[finish].emplace_back(weight, start);
   }
   void BFS(int s, std::vector<bool>& visited, std::vector<int>& comp) {
     visited[s] = true;
@@ -110,7 +98,7 @@ class Graph {
     dist[start] = 0;
     auto comp = Comp(start);
     std::vector<int> prev(graph_.size(), -1);
-    Heap heap(static_cast<int>(graph_.size()));
+    Heap<int> heap(static_cast<int>(graph_.size()));
     for (auto i : comp) {
       heap.Add(i, dist[i]);
       if (i == finish) {
@@ -133,9 +121,131 @@ class Graph {
     }
     return dist[finish];
   }
+  int LazyDijkstra(int start, int finish) {
+    NextEpoch();
+    seen_[start] = epoch_;
+    dist_[start] = 0;
+    prev_[start] = -1;
+    heap_.Add(start, 0);
+    while (!heap_.Empty()) {
+      auto [d, v] = heap_.ExtractMin();
+      ++settled_;
+      if (v == finish) {
+        return d;
+      }
+      for (auto [w, u] : graph_[v]) {
+        if (seen_[u] != epoch_) {
+          seen_[u] = epoch_;
+          dist_[u] = d + w;
+          prev_[u] = v;
+          heap_.Add(u, d + w);
+        } else if (heap_.Contains(u) && d + w < dist_[u]) {
+          dist_[u] = d + w;
+          prev_[u] = v;
+          heap_.DecreaseKey(u, d + w);
+        }
+      }
+    }
+    return -1;
+  }
+  int BidirectionalDijkstra(int start, int finish) {
+    NextEpoch();
+    int inf = 2009000999;
+    int best = inf;
+    seen_[start] = epoch_;
+    dist_[start] = 0;
+    prev_[start] = -1;
+    heap_.Add(start, 0);
+    seen_back_[finish] = epoch_;
+    dist_back_[finish] = 0;
+    next_[finish] = -1;
+    heap_back_.Add(finish, 0);
+    if (start == finish) {
+      meet_ = start;
+      return 0;
+    }
+    while (!heap_.Empty() && !heap_back_.Empty() && heap_.MinKey() + heap_back_.MinKey() < best) {
+      if (heap_.MinKey() <= heap_back_.MinKey()) {
+        auto [d, v] = heap_.ExtractMin();
+        Scan(v, d, graph_, dist_, prev_, seen_, heap_, dist_back_, seen_back_, best);
+      } else {
+        auto [d, v] = heap_back_.ExtractMin();
+        Scan(v, d, reverse_, dist_back_, next_, seen_back_, heap_back_, dist_, seen_, best);
+      }
+    }
+    return best == inf ? -1 : best;
+  }
+  std::vector<int> Path() const {
+    std::vector<int> path;
+    if (meet_ == -1) {
+      return path;
+    }
+    for (int v = meet_; v != -1; v = prev_[v]) {
+      path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    if (seen_back_[meet_] == epoch_) {
+      for (int v = next_[meet_]; v != -1; v = next_[v]) {
+        path.push_back(v);
+      }
+    }
+    return path;
+  }
+  int Settled() const {
+    return settled_;
+  }
 };
 
-int main() {
+void Benchmark(int side, int queries, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  std::uniform_int_distribution<int> vertex(0, side * side - 1);
+  Graph graph(side * side);
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      int v = r * side + c;
+      if (c + 1 < side) {
+        graph.AddEdge(v, v + 1, weight(gen));
+        graph.AddEdge(v + 1, v, weight(gen));
+      }
+      if (r + 1 < side) {
+        graph.AddEdge(v, v + side, weight(gen));
+        graph.AddEdge(v + side, v, weight(gen));
+      }
+    }
+  }
+  int64_t uni_settled = 0;
+  int64_t bi_settled = 0;
+  double uni_ms = 0;
+  double bi_ms = 0;
+  for (int i = 0; i < queries; ++i) {
+    int s = vertex(gen);
+    int t = vertex(gen);
+    auto t0 = std::chrono::steady_clock::now();
+    int uni = graph.LazyDijkstra(s, t);
+    auto t1 = std::chrono::steady_clock::now();
+    uni_settled += graph.Settled();
+    int bi = graph.BidirectionalDijkstra(s, t);
+    auto t2 = std::chrono::steady_clock::now();
+    bi_settled += graph.Settled();
+    uni_ms += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    bi_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+    if (uni != bi) {
+      std::cout << "mismatch on " << s << ' ' << t << ": " << uni << " vs " << bi << '\n';
+    }
+  }
+  std::cout << "grid " << side << 'x' << side << ", " << queries << " queries\n";
+  std::cout << "unidirectional: " << uni_settled / queries << " settled/query, " << uni_ms << " ms\n";
+  std::cout << "bidirectional:  " << bi_settled / queries << " settled/query, " << bi_ms << " ms\n";
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    int side = argc > 2 ? std::stoi(argv[2]) : 1'000;
+    int queries = argc > 3 ? std::stoi(argv[3]) : 100;
+    Benchmark(side, queries, argc > 4 ? std::stoi(argv[4]) : 1);
+    return 0;
+  }
   std::ios::sync_with_stdio(false);
   std::cin.tie(nullptr);
   std::cout.tie(nullptr);
@@ -153,5 +263,5 @@ int main() {
       }
     }
   }
-  std::cout << graph.Dijkstra(s - 1, t - 1);
+  std::cout << graph.LazyDijkstra(s - 1, t - 1);
 }
@@ -1,36 +1,79 @@
 #include <vector>
 #include <iostream>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <string>
 
 struct Edge {
   int u = 0;
-  int f = 0;
-  int c = 0;
+  int64_t f = 0;
+  int64_t c = 0;
   size_t back;
-  explicit Edge(int u0, int c0) : u(u0), c(c0) {
+  explicit Edge(int u0, int64_t c0) : u(u0), c(c0) {
   }
 };
 
+struct Cut {
+  std::vector<bool> source_side;
+  std::vector<int> edges;
+};
+
 class Graph {
   std::vector<std::vector<Edge>> graph_;
+  std::vector<std::pair<int, size_t>> edges_;
+  std::vector<int> level_;
+  std::vector<size_t> arc_;
+  std::vector<bool> visited_;
+  int64_t max_capacity_ = 0;
   int size_;
 
  public:
-  explicit Graph(int n) : graph_(n + 1), size_(n) {
+  explicit Graph(int n) : graph_(n + 1), level_(n + 1), arc_(n + 1), visited_(n + 1), size_(n) {
   }
-  void AddEdge(int v, int u, int c) {
+  int AddEdge(int v, int u, int64_t c, int64_t rc = 0) {
+    if (std::max(c, rc) > max_capacity_) {
+      max_capacity_ = std::max(c, rc);
+    }
+    size_t i = graph_[v].size();
+    size_t j = graph_[u].size() + (v == u ? 1 : 0);
+    edges_.emplace_back(v, i);
     graph_[v].emplace_back(Edge(u, c));
-    graph_[u].emplace_back(Edge(v, 0));
-    graph_[v].back().back = graph_[u].size() - 1;
-    graph_[u].back().back = graph_[v].size() - 1;
+    graph_[u].emplace_back(Edge(v, rc));
+    graph_[v][i].back = j;
+    graph_[u][j].back = i;
+    return static_cast<int>(edges_.size()) - 1;
+  }
+  void SetCapacity(int id, int64_t c) {
+    auto [v, i] = edges_[id];
+    auto& edge = graph_[v][i];
+    int u = edge.u;
+    if (c > max_capacity_) {
+      max_capacity_ = c;
+    }
+    int64_t excess = edge.f - c;
+    edge.c = c;
+    if (excess <= 0) {
+      return;
+    }
+    edge.f = c;
+    graph_[u][edge.back].f = -c;
+    excess -= Augment(v, u, excess);
+    if (excess > 0 && v != 1 && v != size_) {
+      Augment(v, 1, excess);
+    }
+    if (excess > 0 && u != 1 && u != size_) {
+      Augment(size_, u, excess);
+    }
   }
-  int DFS(int v, int cmin, std::vector<bool>& visited) {
+  int64_t DFS(int v, int64_t cmin, std::vector<bool>& visited) {
     if (v == size_) {
       return cmin;
     }
     visited[v] = true;
     for (auto& edge : graph_[v]) {
       if (!visited[edge.u] && edge.f < edge.c) {
-        int delta = DFS(edge.u, std::min(cmin, edge.c - edge.f), visited);
+        int64_t delta = DFS(edge.u, std::min(cmin, edge.c - edge.f), visited);
         if (delta > 0) {
           edge.f += delta;
           graph_[edge.u][edge.back].f -= delta;
@@ -40,11 +83,11 @@ class Graph {
     }
     return 0;
   }
-  int FF() {
-    int flow = 0;
+  int64_t FF() {
+    int64_t flow = 0;
     while (true) {
       std::vector<bool> visited(size_ + 1, false);
-      int cur = DFS(1, 100000, visited);
+      int64_t cur = DFS(1, std::numeric_limits<int64_t>::max(), visited);
       if (cur == 0) {
         break;
       }
@@ -52,9 +95,222 @@ class Graph {
     }
     return flow;
   }
+  bool Levels(int start, int finish) {
+    std::fill(level_.begin(), level_.end(), -1);
+    level_[start] = 0;
+    std::queue<int> queue;
+    queue.push(start);
+    while (!queue.empty()) {
+      int v = queue.front();
+      queue.pop();
+      for (auto& edge : graph_[v]) {
+        if (edge.f < edge.c && level_[edge.u] == -1) {
+          level_[edge.u] = level_[v] + 1;
+          queue.push(edge.u);
+        }
+      }
+    }
+    return level_[finish] != -1;
+  }
+  int64_t BlockingDFS(int v, int finish, int64_t cmin) {
+    if (v == finish) {
+      return cmin;
+    }
+    for (size_t& i = arc_[v]; i < graph_[v].size(); ++i) {
+      auto& edge = graph_[v][i];
+      if (edge.f < edge.c && level_[edge.u] == level_[v] + 1) {
+        int64_t delta = BlockingDFS(edge.u, finish, std::min(cmin, edge.c - edge.f));
+        if (delta > 0) {
+          edge.f += delta;
+          graph_[edge.u][edge.back].f -= delta;
+          return delta;
+        }
+      }
+    }
+    return 0;
+  }
+  int64_t Augment(int start, int finish, int64_t limit) {
+    int64_t flow = 0;
+    while (flow < limit && Levels(start, finish)) {
+      std::fill(arc_.begin(), arc_.end(), 0);
+      while (flow < limit) {
+        int64_t cur = BlockingDFS(start, finish, limit - flow);
+        if (cur == 0) {
+          break;
+        }
+        flow += cur;
+      }
+    }
+    return flow;
+  }
+  int64_t Dinic() {
+    return Augment(1, size_, std::numeric_limits<int64_t>::max());
+  }
+  void ResetFlow() {
+    for (auto& edges : graph_) {
+      for (auto& edge : edges) {
+        edge.f = 0;
+      }
+    }
+  }
+  bool Reachable(int v) const {
+    return level_[v] != -1;
+  }
+  int Size() const {
+    return size_;
+  }
+  int64_t Resume() {
+    Dinic();
+    return FlowValue();
+  }
+  Cut MinCut() {
+    Cut cut;
+    cut.source_side.assign(size_ + 1, true);
+    cut.source_side[0] = false;
+    cut.source_side[size_] = false;
+    std::vector<int> queue = {size_};
+    for (size_t i = 0; i < queue.size(); ++i) {
+      int v = queue[i];
+      for (auto& edge : graph_[v]) {
+        auto& rev = graph_[edge.u][edge.back];
+        if (rev.f < rev.c && cut.source_side[edge.u]) {
+          cut.source_side[edge.u] = false;
+          queue.push_back(edge.u);
+        }
+      }
+    }
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      auto [v, idx] = edges_[i];
+      if (cut.source_side[v] && !cut.source_side[graph_[v][idx].u]) {
+        cut.edges.push_back(static_cast<int>(i));
+      }
+    }
+    return cut;
+  }
+  std::vector<int64_t> Snapshot() const {
+    std::vector<int64_t> flows(edges_.size());
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      flows[i] = graph_[edges_[i].first][edges_[i].second].f;
+    }
+    return flows;
+  }
+  void Restore(const std::vector<int64_t>& flows) {
+    for (size_t i = 0; i < edges_.size(); ++i) {
+      auto& edge = graph_[edges_[i].first][edges_[i].second];
+      edge.f = flows[i];
+      graph_[edge.u][edge.back].f = -flows[i];
+    }
+  }
+  int64_t FlowValue() const {
+    int64_t flow = 0;
+    for (auto& edge : graph_[1]) {
+      flow += edge.f;
+    }
+    return flow;
+  }
+  int64_t ScalingDFS(int v, int64_t cmin, int64_t delta) {
+    if (v == size_) {
+      return cmin;
+    }
+    visited_[v] = true;
+    for (auto& edge : graph_[v]) {
+      if (!visited_[edge.u] && edge.c - edge.f >= delta) {
+        int64_t pushed = ScalingDFS(edge.u, std::min(cmin, edge.c - edge.f), delta);
+        if (pushed > 0) {
+          edge.f += pushed;
+          graph_[edge.u][edge.back].f -= pushed;
+          return pushed;
+        }
+      }
+    }
+    return 0;
+  }
+  int64_t Scaling() {
+    int64_t flow = 0;
+    int64_t delta = 1;
+    while (delta <= max_capacity_ / 2) {
+      delta *= 2;
+    }
+    for (; delta > 0; delta /= 2) {
+      while (true) {
+        std::fill(visited_.begin(), visited_.end(), false);
+        int64_t cur = ScalingDFS(1, std::numeric_limits<int64_t>::max(), delta);
+        if (cur == 0) {
+          break;
+        }
+        flow += cur;
+      }
+    }
+    return flow;
+  }
 };
 
-int main() {
+class GomoryHuTree {
+  std::vector<std::vector<int>> up_;
+  std::vector<std::vector<int64_t>> min_;
+  std::vector<int> depth_;
+
+ public:
+  explicit GomoryHuTree(Graph& graph) {
+    int n = graph.Size();
+    int log = 1;
+    while ((1 << log) < n + 1) {
+      ++log;
+    }
+    std::vector<int> parent(n + 1, 1);
+    std::vector<int64_t> weight(n + 1, std::numeric_limits<int64_t>::max());
+    for (int s = 2; s <= n; ++s) {
+      int t = parent[s];
+      graph.ResetFlow();
+      weight[s] = graph.Augment(s, t, std::numeric_limits<int64_t>::max());
+      for (int v = s + 1; v <= n; ++v) {
+        if (parent[v] == t && graph.Reachable(v)) {
+          parent[v] = s;
+        }
+      }
+    }
+    graph.ResetFlow();
+    up_.assign(log, std::vector<int>(n + 1, 1));
+    min_.assign(log, std::vector<int64_t>(n + 1, std::numeric_limits<int64_t>::max()));
+    depth_.assign(n + 1, 0);
+    for (int v = 2; v <= n; ++v) {
+      depth_[v] = depth_[parent[v]] + 1;
+      up_[0][v] = parent[v];
+      min_[0][v] = weight[v];
+    }
+    for (int k = 1; k < log; ++k) {
+      for (int v = 1; v <= n; ++v) {
+        up_[k][v] = up_[k - 1][up_[k - 1][v]];
+        min_[k][v] = std::min(min_[k - 1][v], min_[k - 1][up_[k - 1][v]]);
+      }
+    }
+  }
+  int64_t MinCut(int v, int u) {
+    int64_t cut = std::numeric_limits<int64_t>::max();
+    if (depth_[v] < depth_[u]) {
+      std::swap(v, u);
+    }
+    for (int k = static_cast<int>(up_.size()) - 1; k >= 0; --k) {
+      if (depth_[v] - (1 << k) >= depth_[u]) {
+        cut = std::min(cut, min_[k][v]);
+        v = up_[k][v];
+      }
+    }
+    if (v == u) {
+      return cut;
+    }
+    for (int k = static_cast<int>(up_.size()) - 1; k >= 0; --k) {
+      if (up_[k][v] != up_[k][u]) {
+        cut = std::min({cut, min_[k][v], min_[k][u]});
+        v = up_[k][v];
+        u = up_[k][u];
+      }
+    }
+    return std::min({cut, min_[0][v], min_[0][u]});
+  }
+};
+
+int main(int argc, char* argv[]) {
   std::ios::sync_with_stdio(false);
   std::cin.tie(nullptr);
   std::cout.tie(nullptr);
@@ -62,12 +318,47 @@ int main() {
   int m = 0;
   int v = 0;
   int u = 0;
-  int c = 0;
+  int64_t c = 0;
+  std::string mode = argc > 1 ? argv[1] : "";
   std::cin >> n >> m;
   Graph graph(n);
   for (int i = 0; i < m; ++i) {
     std::cin >> v >> u >> c;
-    graph.AddEdge(v, u, c);
+    if (mode == "gomory-hu") {
+      graph.AddEdge(v, u, c, c);
+    } else {
+      graph.AddEdge(v, u, c);
+    }
+  }
+  if (mode == "gomory-hu") {
+    GomoryHuTree tree(graph);
+    int q = 0;
+    std::cin >> q;
+    for (int i = 0; i < q; ++i) {
+      std::cin >> v >> u;
+      if (v == u) {
+        std::cout << "inf\n";
+      } else {
+        std::cout << tree.MinCut(v, u) << '\n';
+      }
+    }
+    return 0;
+  }
+  std::cout << graph.Dinic() << '\n';
+  if (mode == "incremental") {
+    int q = 0;
+    int type = 0;
+    std::cin >> q;
+    for (int i = 0; i < q; ++i) {
+      std::cin >> type;
+      if (type == 1) {
+        std::cin >> v >> c;
+        graph.SetCapacity(v, c);
+      } else {
+        std::cin >> v >> u >> c;
+        graph.AddEdge(v, u, c);
+      }
+      std::cout << graph.Resume() << '\n';
+    }
   }
-  std::cout << graph.FF() << '\n';
 }
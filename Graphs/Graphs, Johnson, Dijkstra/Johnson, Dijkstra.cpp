@@ -1,83 +1,174 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
-class Heap {
-  int size_ = 0;
-  std::vector<std::pair<int, int>> heap_;
-  std::vector<int> map_;
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
- public:
-  explicit Heap(int max_size) : heap_(max_size), map_(max_size, -1) {
-  }
-  int Parent(int i) {
-    return (i - 1) / 2;
-  }
-  int LeftChild(int i) {
-    return i * 2 + 1;
+#include "../heap/heap.h"
+
+enum class ApspKind { kAuto, kDijkstra, kFloydWarshall };
+
+constexpr int32_t kUnreachable = 0x3f3f3f3f;
+constexpr size_t kBlock = 64;
+#ifdef __AVX2__
+constexpr int64_t kDensity = 64;
+#else
+constexpr int64_t kDensity = 8;
+#endif
+
+template <class F>
+void Parallel(int threads, F&& fn) {
+  std::vector<std::thread> workers;
+  for (int id = 1; id < threads; ++id) {
+    workers.emplace_back(fn, id);
   }
-  int RightChild(int i) {
-    return i * 2 + 2;
+  fn(0);
+  for (auto& worker : workers) {
+    worker.join();
   }
-  int SiftUp(int i) {
-    int parent = Parent(i);
-    if (i > 0 && heap_[parent].first > heap_[i].first) {
-      std::swap(heap_[parent], heap_[i]);
-      std::swap(map_[heap_[parent].second], map_[heap_[i].second]);
-      i = SiftUp(parent);
+}
+
+void MinPlus(int32_t* c, const int32_t* a, const int32_t* b, size_t stride) {
+  for (size_t k = 0; k < kBlock; ++k) {
+    const int32_t* row = b + k * stride;
+    for (size_t i = 0; i < kBlock; ++i) {
+      int32_t via = a[i * stride + k];
+      if (via >= kUnreachable) {
+        continue;
+      }
+      int32_t* out = c + i * stride;
+#ifdef __AVX2__
+      __m256i add = _mm256_set1_epi32(via);
+      for (size_t j = 0; j < kBlock; j += 8) {
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + j));
+        __m256i alt = _mm256_add_epi32(add, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + j)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j), _mm256_min_epi32(cur, alt));
+      }
+#else
+      for (size_t j = 0; j < kBlock; ++j) {
+        out[j] = std::min(out[j], via + row[j]);
+      }
+#endif
     }
-    return i;
-  }
-  void Add(int x, int w) {
-    heap_[size_++].first = w;
-    heap_[size_ - 1].second = x;
-    map_[x] = size_ - 1;
-    SiftUp(size_ - 1);
   }
-  int SiftDown(int i) {
-    int left = LeftChild(i);
-    int right = RightChild(i);
-    int largest = i;
-    if (left < size_ && heap_[left].first < heap_[largest].first) {
-      largest = left;
+}
+
+class DistanceOracle {
+  void* map_ = nullptr;
+  size_t map_size_ = 0;
+  int32_t* dist_ = nullptr;
+  int size_ = 0;
+
+  static constexpr int32_t kMagic = 0x4f535041;
+
+  bool Open(const std::string& path, int flags, int prot, size_t size) {
+    int fd = open(path.c_str(), flags, 0644);
+    if (fd == -1) {
+      return false;
+    }
+    struct stat st {};
+    if (size > 0 ? ftruncate(fd, static_cast<off_t>(size)) == -1 : fstat(fd, &st) == -1) {
+      close(fd);
+      return false;
+    }
+    if (size == 0) {
+      size = st.st_size;
     }
-    if (right < size_ && heap_[right].first < heap_[largest].first) {
-      largest = right;
+    if (size < 2 * sizeof(int32_t)) {
+      close(fd);
+      return false;
     }
-    if (largest != i) {
-      std::swap(heap_[largest], heap_[i]);
-      std::swap(map_[heap_[largest].second], map_[heap_[i].second]);
-      i = SiftDown(largest);
+    void* map = mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+      return false;
     }
-    return i;
+    map_ = map;
+    map_size_ = size;
+    return true;
   }
-  std::pair<int, int> ExtractMin() {
-    if (size_ > 1) {
-      auto val = heap_[0];
-      --size_;
-      std::swap(heap_[0], heap_[size_]);
-      std::swap(map_[heap_[0].second], map_[heap_[size_].second]);
-      SiftDown(0);
-      return val;
+
+ public:
+  DistanceOracle() = default;
+  DistanceOracle(const DistanceOracle&) = delete;
+  DistanceOracle& operator=(const DistanceOracle&) = delete;
+  ~DistanceOracle() {
+    if (map_ != nullptr) {
+      munmap(map_, map_size_);
+    }
+  }
+  bool Create(const std::string& path, int n) {
+    size_t size = sizeof(int32_t) * (2 + static_cast<size_t>(n) * n);
+    if (!Open(path, O_RDWR | O_CREAT | O_TRUNC, PROT_READ | PROT_WRITE, size)) {
+      return false;
+    }
+    auto* header = static_cast<int32_t*>(map_);
+    header[0] = kMagic;
+    header[1] = n;
+    dist_ = header + 2;
+    size_ = n;
+    return true;
+  }
+  bool Map(const std::string& path) {
+    if (!Open(path, O_RDONLY, PROT_READ, 0)) {
+      return false;
+    }
+    const auto* header = static_cast<const int32_t*>(map_);
+    if (header[0] != kMagic || header[1] < 0 ||
+        map_size_ != sizeof(int32_t) * (2 + static_cast<size_t>(header[1]) * header[1])) {
+      munmap(map_, map_size_);
+      map_ = nullptr;
+      return false;
     }
-    --size_;
-    return heap_[0];
+    size_ = header[1];
+    dist_ = static_cast<int32_t*>(map_) + 2;
+    return true;
   }
-  void DecreaseKey(int x, int new_w) {
-    int i = map_[x];
-    heap_[i].first = new_w;
-    SiftUp(i);
+  int Size() const {
+    return size_;
   }
-  bool Empty() {
-    return size_ == 0;
+  int32_t* Data() {
+    return dist_;
   }
-  bool Contains(int i) {
-    return map_[i] < size_;
+  int Distance(int u, int v) const {
+    return dist_[static_cast<size_t>(u) * size_ + v];
   }
 };
 
 class Graph {
   std::vector<std::vector<std::pair<int, int>>> graph_;
   int inf_ = 2009000999;
+  std::vector<int> cycle_;
+
+  std::vector<int> Cycle(int v, const std::vector<int>& prev) {
+    std::vector<bool> visited(graph_.size(), false);
+    while (!visited[v]) {
+      visited[v] = true;
+      v = prev[v];
+    }
+    std::vector<int> cycle{v};
+    for (int u = prev[v]; u != v; u = prev[u]) {
+      cycle.push_back(u);
+    }
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+  }
 
  public:
   explicit Graph(size_t n) : graph_(n) {
@@ -108,68 +199,249 @@ class Graph {
     }
     return false;
   }
-  std::vector<int> BF(int start) {
-    std::vector<int> dist(graph_.size(), inf_);
-    dist[start] = 0;
-    auto comp = Comp(start);
-    std::vector<int> prev(graph_.size(), -1);
-    for (size_t i = 0; i < comp.size() - 1; ++i) {
-      for (auto v : comp) {
-        for (auto [w, u] : graph_[v]) {
-          Relax(v, u, w, dist, prev);
+  std::vector<int> Potentials() {
+    int n = static_cast<int>(graph_.size());
+    std::vector<int> dist(n, 0);
+    std::vector<int> prev(n, -1);
+    std::vector<int> count(n, 1);
+    std::vector<bool> queued(n, true);
+    std::queue<int> queue;
+    for (int v = 0; v < n; ++v) {
+      queue.push(v);
+    }
+    cycle_.clear();
+    while (!queue.empty()) {
+      int v = queue.front();
+      queue.pop();
+      queued[v] = false;
+      for (auto [w, u] : graph_[v]) {
+        if (!Relax(v, u, w, dist, prev)) {
+          continue;
+        }
+        count[u] = count[v] + 1;
+        if (count[u] > n) {
+          return BellmanFord();
+        }
+        if (!queued[u]) {
+          queued[u] = true;
+          queue.push(u);
         }
       }
     }
     return dist;
   }
-  std::vector<int> Dijkstra(int start) {
-    std::vector<int> dist(graph_.size(), inf_);
-    dist[start] = 0;
-    auto comp = Comp(start);
-    std::vector<int> prev(graph_.size(), -1);
-    Heap heap(static_cast<int>(graph_.size()));
-    for (auto i : comp) {
-      heap.Add(i, dist[i]);
+  std::vector<int> BellmanFord() {
+    int n = static_cast<int>(graph_.size());
+    std::vector<int64_t> dist(n, 0);
+    std::vector<int> prev(n, -1);
+    int last = -1;
+    for (int pass = 0; pass < n; ++pass) {
+      last = -1;
+      for (int v = 0; v < n; ++v) {
+        for (auto [w, u] : graph_[v]) {
+          if (dist[v] + w < dist[u]) {
+            dist[u] = dist[v] + w;
+            prev[u] = v;
+            last = u;
+          }
+        }
+      }
+      if (last == -1) {
+        break;
+      }
     }
+    if (last == -1) {
+      return std::vector<int>(dist.begin(), dist.end());
+    }
+    for (int i = 0; i < n; ++i) {
+      last = prev[last];
+    }
+    cycle_ = Cycle(last, prev);
+    return {};
+  }
+  const std::vector<int>& NegativeCycle() const {
+    return cycle_;
+  }
+  int MaxDistance(int start, const std::vector<int>& potential, Heap<int>& heap, std::vector<int>& dist,
+                  std::vector<uint32_t>& seen, uint32_t epoch, int32_t* row = nullptr) {
+    int max_dist = -1'000'000;
+    if (row != nullptr) {
+      std::fill(row, row + graph_.size(), inf_);
+    }
+    seen[start] = epoch;
+    dist[start] = 0;
+    heap.Add(start, 0);
     while (!heap.Empty()) {
-      auto min = heap.ExtractMin();
-      int v = min.second;
+      auto [d, v] = heap.ExtractMin();
+      if (d - (potential[start] - potential[v]) > max_dist) {
+        max_dist = d - (potential[start] - potential[v]);
+      }
+      if (row != nullptr) {
+        row[v] = d - (potential[start] - potential[v]);
+      }
       for (auto [w, u] : graph_[v]) {
-        if (heap.Contains(u) && w + dist[v] < dist[u]) {
-          prev[u] = v;
-          dist[u] = w + dist[v];
-          heap.DecreaseKey(u, w + dist[v]);
+        if (seen[u] != epoch) {
+          seen[u] = epoch;
+          dist[u] = w + d;
+          heap.Add(u, dist[u]);
+        } else if (heap.Contains(u) && w + d < dist[u]) {
+          dist[u] = w + d;
+          heap.DecreaseKey(u, dist[u]);
         }
       }
     }
+    return max_dist;
+  }
+  std::vector<int32_t> FloydWarshall(int threads, size_t& stride) {
+    size_t n = graph_.size();
+    size_t blocks = (n + kBlock - 1) / kBlock;
+    stride = blocks * kBlock;
+    std::vector<int32_t> dist(stride * stride, kUnreachable);
+    for (size_t v = 0; v < n; ++v) {
+      dist[v * stride + v] = 0;
+      for (auto [w, u] : graph_[v]) {
+        dist[v * stride + u] = std::min(dist[v * stride + u], w);
+      }
+    }
+    auto at = [&](size_t i, size_t j) {
+      return dist.data() + i * kBlock * stride + j * kBlock;
+    };
+    threads = std::max(1, std::min(threads, static_cast<int>(blocks)));
+    for (size_t k = 0; k < blocks; ++k) {
+      MinPlus(at(k, k), at(k, k), at(k, k), stride);
+      Parallel(threads, [&](int id) {
+        for (size_t i = id; i < blocks; i += threads) {
+          if (i != k) {
+            MinPlus(at(i, k), at(i, k), at(k, k), stride);
+            MinPlus(at(k, i), at(k, k), at(k, i), stride);
+          }
+        }
+      });
+      Parallel(threads, [&](int id) {
+        for (size_t i = id; i < blocks; i += threads) {
+          for (size_t j = 0; j < blocks; ++j) {
+            if (i != k && j != k) {
+              MinPlus(at(i, j), at(i, k), at(k, j), stride);
+            }
+          }
+        }
+      });
+    }
     return dist;
   }
-  int Johnson() {
-    Graph modified(graph_.size() + 1);
-    for (size_t i = 0; i < graph_.size(); ++i) {
-      modified.graph_[i] = graph_[i];
-      modified.AddEdge(static_cast<int>(graph_.size()), static_cast<int>(i), 0);
+  int Johnson(int threads = 0, ApspKind kind = ApspKind::kAuto, int32_t* matrix = nullptr) {
+    auto mod_bf = Potentials();
+    if (!cycle_.empty()) {
+      return -inf_;
     }
-    auto mod_bf = modified.BF(static_cast<int>(graph_.size()));
     for (size_t v = 0; v < graph_.size(); ++v) {
       for (auto& [w, u] : graph_[v]) {
         w = w + mod_bf[v] - mod_bf[u];
       }
     }
-    int max_dist = -1'000'000;
-    for (size_t i = 0; i < graph_.size(); ++i) {
-      auto dist = Dijkstra(static_cast<int>(i));
-      for (size_t j = 0; j < dist.size(); ++j) {
-        if (dist[j] != inf_ && dist[j] - (mod_bf[i] - mod_bf[j]) > max_dist) {
-          max_dist = dist[j] - (mod_bf[i] - mod_bf[j]);
+    int n = static_cast<int>(graph_.size());
+    if (threads <= 0) {
+      threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    int64_t arcs = 0;
+    int64_t max_weight = 0;
+    for (auto& edges : graph_) {
+      arcs += static_cast<int64_t>(edges.size());
+      for (auto [w, u] : edges) {
+        max_weight = std::max<int64_t>(max_weight, w);
+      }
+    }
+    if (kind == ApspKind::kAuto) {
+      kind = arcs * kDensity >= static_cast<int64_t>(n) * n ? ApspKind::kFloydWarshall : ApspKind::kDijkstra;
+    }
+    if (kind == ApspKind::kFloydWarshall && max_weight * std::max(1, n - 1) < kUnreachable) {
+      size_t stride = 0;
+      auto dist = FloydWarshall(threads, stride);
+      int max_dist = -1'000'000;
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          int32_t d = dist[i * stride + j];
+          if (d < kUnreachable && d - (mod_bf[i] - mod_bf[j]) > max_dist) {
+            max_dist = d - (mod_bf[i] - mod_bf[j]);
+          }
+          if (matrix != nullptr) {
+            matrix[static_cast<size_t>(i) * n + j] = d < kUnreachable ? d - (mod_bf[i] - mod_bf[j]) : inf_;
+          }
         }
       }
+      return max_dist;
     }
+    threads = std::max(1, std::min(threads, n));
+    std::vector<int> local(threads, -1'000'000);
+    std::atomic<int> next{0};
+    Parallel(threads, [&](int id) {
+      Heap<int> heap(n);
+      std::vector<int> dist(n);
+      std::vector<uint32_t> seen(n, 0);
+      for (int i = next++; i < n; i = next++) {
+        int32_t* row = matrix != nullptr ? matrix + static_cast<size_t>(i) * n : nullptr;
+        local[id] = std::max(local[id], MaxDistance(i, mod_bf, heap, dist, seen, i + 1, row));
+      }
+    });
+    int max_dist = *std::max_element(local.begin(), local.end());
     return max_dist;
   }
 };
 
-int main() {
+void Benchmark(int n, int threads) {
+  std::mt19937 rng(2009);
+  std::cout << "n = " << n << ", threads = " << threads << '\n';
+  std::cout << "edges\tdijkstra_ms\tfloyd_warshall_ms\n";
+  for (int64_t m = n; m <= static_cast<int64_t>(n) * n; m *= 2) {
+    std::vector<std::tuple<int, int, int>> edges(m);
+    for (auto& [s, f, w] : edges) {
+      s = static_cast<int>(rng() % n);
+      f = static_cast<int>(rng() % n);
+      w = static_cast<int>(rng() % 1000);
+    }
+    std::cout << m;
+    int answer = 0;
+    for (auto kind : {ApspKind::kDijkstra, ApspKind::kFloydWarshall}) {
+      Graph graph(n);
+      for (auto [s, f, w] : edges) {
+        graph.AddEdge(s, f, w);
+      }
+      auto begin = std::chrono::steady_clock::now();
+      int result = graph.Johnson(threads, kind);
+      auto end = std::chrono::steady_clock::now();
+      if (kind == ApspKind::kDijkstra) {
+        answer = result;
+      } else if (result != answer) {
+        std::cout << "\tmismatch";
+      }
+      std::cout << '\t' << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+    }
+    std::cout << '\n';
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "bench") {
+    Benchmark(argc > 2 ? std::stoi(argv[2]) : 1024, argc > 3 ? std::stoi(argv[3]) : 1);
+    return 0;
+  }
+  if (mode == "query") {
+    DistanceOracle oracle;
+    if (argc < 3 || !oracle.Map(argv[2])) {
+      std::cerr << "cannot map distance file\n";
+      return 1;
+    }
+    int q = 0;
+    int u = 0;
+    int v = 0;
+    std::cin >> q;
+    for (int i = 0; i < q; ++i) {
+      std::cin >> u >> v;
+      std::cout << oracle.Distance(u, v) << '\n';
+    }
+    return 0;
+  }
   int n = 0;
   int m = 0;
   int s = 0;
@@ -181,6 +453,23 @@ int main() {
     std::cin >> s >> f >> w;
     graph.AddEdge(s, f, w);
   }
-  std::cout << graph.Johnson() << '\n';
+  DistanceOracle oracle;
+  if (mode == "build" && (argc < 3 || !oracle.Create(argv[2], n))) {
+    std::cerr << "cannot create distance file\n";
+    return 1;
+  }
+  int max_dist = graph.Johnson(0, ApspKind::kAuto, mode == "build" ? oracle.Data() : nullptr);
+  if (!graph.NegativeCycle().empty()) {
+    if (mode == "build") {
+      std::remove(argv[2]);
+    }
+    std::cout << "Negative cycle:";
+    for (auto v : graph.NegativeCycle()) {
+      std::cout << ' ' << v;
+    }
+  } else {
+    std::cout << max_dist;
+  }
+  std::cout << '\n';
   return 0;
 }
@@ -1,79 +1,7 @@
 #include <iostream>
 #include <vector>
 
-class Heap {
-  int size_ = 0;
-  std::vector<std::pair<int, int>> heap_;
-  std::vector<int> map_;
-
- public:
-  explicit Heap(int max_size) : heap_(max_size), map_(max_size, -1) {
-  }
-  int Parent(int i) {
-    return (i - 1) / 2;
-  }
-  int LeftChild(int i) {
-    return i * 2 + 1;
-  }
-  int RightChild(int i) {
-    return i * 2 + 2;
-  }
-  int SiftUp(int i) {
-    int parent = Parent(i);
-    if (i > 0 && heap_[parent].first > heap_[i].first) {
-      std::swap(heap_[parent], heap_[i]);
-      std::swap(map_[heap_[parent].second], map_[heap_[i].second]);
-      i = SiftUp(parent);
-    }
-    return i;
-  }
-  void Add(int x, int w) {
-    heap_[size_++].first = w;
-    heap_[size_ - 1].second = x;
-    map_[x] = size_ - 1;
-    SiftUp(size_ - 1);
-  }
-  int SiftDown(int i) {
-    int left = LeftChild(i);
-    int right = RightChild(i);
-    int largest = i;
-    if (left < size_ && heap_[left].first < heap_[largest].first) {
-      largest = left;
-    }
-    if (right < size_ && heap_[right].first < heap_[largest].first) {
-      largest = right;
-    }
-    if (largest != i) {
-      std::swap(heap_[largest], heap_[i]);
-      std::swap(map_[heap_[largest].second], map_[heap_[i].second]);
-      i = SiftDown(largest);
-    }
-    return i;
-  }
-  std::pair<int, int> ExtractMin() {
-    if (size_ > 1) {
-      auto val = heap_[0];
-      --size_;
-      std::swap(heap_[0], heap_[size_]);
-      std::swap(map_[heap_[0].second], map_[heap_[size_].second]);
-      SiftDown(0);
-      return val;
-    }
-    --size_;
-    return heap_[0];
-  }
-  void DecreaseKey(int x, int new_w) {
-    int i = map_[x];
-    heap_[i].first = new_w;
-    SiftUp(i);
-  }
-  bool Empty() {
-    return size_ == 0;
-  }
-  bool Contains(int i) {
-    return map_[i] < size_;
-  }
-};
+#include "../heap/heap.h"
 
 class Graph {
   std::vector<std::vector<std::pair<int, int>>> graph_;
@@ -95,7 +23,7 @@ class Graph {
     std::vector<int> dist(graph_.size(), inf);
     dist[0] = 0;
     std::vector<int> prev(graph_.size(), -1);
-    Heap heap(static_cast<int>(graph_.size()));
+    Heap<int> heap(static_cast<int>(graph_.size()));
     for (size_t i = 0; i < graph_.size(); ++i) {
       heap.Add(static_cast<int>(i), dist[i]);
     }
@@ -0,0 +1,265 @@
+#include <vector>
+#include <iostream>
+#include <queue>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "../heap/heap.h"
+
+struct Edge {
+  int u = 0;
+  int64_t f = 0;
+  int64_t c = 0;
+  int64_t cost = 0;
+  size_t back = 0;
+  Edge(int u0, int64_t c0, int64_t cost0) : u(u0), c(c0), cost(cost0) {
+  }
+};
+
+class Graph {
+  std::vector<std::vector<Edge>> graph_;
+  std::vector<int64_t> potential_;
+  std::vector<int64_t> excess_;
+  std::vector<size_t> arc_;
+  int64_t max_cost_ = 0;
+  int size_;
+
+  void AddArc(int v, int u, int64_t c, int64_t cost) {
+    size_t i = graph_[v].size();
+    size_t j = graph_[u].size() + (v == u ? 1 : 0);
+    graph_[v].emplace_back(Edge(u, c, cost));
+    graph_[u].emplace_back(Edge(v, 0, -cost));
+    graph_[v][i].back = j;
+    graph_[u][j].back = i;
+  }
+  void BF(int start) {
+    int64_t inf = std::numeric_limits<int64_t>::max();
+    potential_.assign(size_ + 1, inf);
+    potential_[start] = 0;
+    bool changed = true;
+    for (int i = 0; i < size_ && changed; ++i) {
+      changed = false;
+      for (int v = 1; v <= size_; ++v) {
+        if (potential_[v] == inf) {
+          continue;
+        }
+        for (auto& edge : graph_[v]) {
+          if (edge.f < edge.c && potential_[v] + edge.cost < potential_[edge.u]) {
+            potential_[edge.u] = potential_[v] + edge.cost;
+            changed = true;
+          }
+        }
+      }
+    }
+    for (auto& p : potential_) {
+      if (p == inf) {
+        p = 0;
+      }
+    }
+  }
+  bool Dijkstra(int start, int finish, std::vector<Edge*>& parent) {
+    int64_t inf = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> dist(size_ + 1, inf);
+    dist[start] = 0;
+    Heap<int64_t> heap(size_ + 1);
+    for (int v = 1; v <= size_; ++v) {
+      heap.Add(v, dist[v]);
+    }
+    while (!heap.Empty()) {
+      auto [d, v] = heap.ExtractMin();
+      if (d == inf) {
+        break;
+      }
+      for (auto& edge : graph_[v]) {
+        int64_t w = edge.cost + potential_[v] - potential_[edge.u];
+        if (edge.f < edge.c && heap.Contains(edge.u) && d + w < dist[edge.u]) {
+          dist[edge.u] = d + w;
+          parent[edge.u] = &edge;
+          heap.DecreaseKey(edge.u, d + w);
+        }
+      }
+    }
+    if (dist[finish] == inf) {
+      return false;
+    }
+    for (int v = 1; v <= size_; ++v) {
+      potential_[v] += std::min(dist[v], dist[finish]);
+    }
+    return true;
+  }
+  int64_t Reduced(int v, const Edge& edge) {
+    return edge.cost + potential_[v] - potential_[edge.u];
+  }
+  void Push(int v, Edge& edge, int64_t delta, std::queue<int>& active) {
+    edge.f += delta;
+    graph_[edge.u][edge.back].f -= delta;
+    excess_[v] -= delta;
+    if (excess_[edge.u] <= 0 && excess_[edge.u] + delta > 0) {
+      active.push(edge.u);
+    }
+    excess_[edge.u] += delta;
+  }
+  void Refine(int64_t eps) {
+    std::queue<int> active;
+    for (int v = 1; v <= size_; ++v) {
+      for (auto& edge : graph_[v]) {
+        if (edge.f < edge.c && Reduced(v, edge) < 0) {
+          Push(v, edge, edge.c - edge.f, active);
+        }
+      }
+    }
+    std::fill(arc_.begin(), arc_.end(), 0);
+    while (!active.empty()) {
+      int v = active.front();
+      active.pop();
+      while (excess_[v] > 0) {
+        if (arc_[v] == graph_[v].size()) {
+          int64_t best = std::numeric_limits<int64_t>::min();
+          for (auto& edge : graph_[v]) {
+            if (edge.f < edge.c) {
+              best = std::max(best, potential_[edge.u] - edge.cost);
+            }
+          }
+          potential_[v] = best - eps;
+          arc_[v] = 0;
+          continue;
+        }
+        auto& edge = graph_[v][arc_[v]];
+        if (edge.f < edge.c && Reduced(v, edge) < 0) {
+          Push(v, edge, std::min(excess_[v], edge.c - edge.f), active);
+        } else {
+          ++arc_[v];
+        }
+      }
+    }
+  }
+
+ public:
+  explicit Graph(int n) : graph_(n + 1), size_(n) {
+  }
+  void AddEdge(int v, int u, int64_t c, int64_t cost) {
+    max_cost_ = std::max(max_cost_, std::abs(cost));
+    AddArc(v, u, c, cost);
+  }
+  std::pair<int64_t, int64_t> SSP() {
+    int64_t flow = 0;
+    int64_t cost = 0;
+    if (size_ == 1) {
+      return {flow, cost};
+    }
+    BF(1);
+    std::vector<Edge*> parent(size_ + 1, nullptr);
+    while (Dijkstra(1, size_, parent)) {
+      int64_t cmin = std::numeric_limits<int64_t>::max();
+      for (int v = size_; v != 1;) {
+        Edge* edge = parent[v];
+        cmin = std::min(cmin, edge->c - edge->f);
+        v = graph_[v][edge->back].u;
+      }
+      for (int v = size_; v != 1;) {
+        Edge* edge = parent[v];
+        auto& rev = graph_[v][edge->back];
+        edge->f += cmin;
+        rev.f -= cmin;
+        cost += cmin * edge->cost;
+        v = rev.u;
+      }
+      flow += cmin;
+    }
+    return {flow, cost};
+  }
+  std::pair<int64_t, int64_t> CostScaling(int alpha = 8) {
+    if (size_ == 1) {
+      return {0, 0};
+    }
+    int64_t n = size_ + 1;
+    int64_t bound = 0;
+    for (auto& edge : graph_[1]) {
+      bound += edge.c;
+    }
+    int64_t price = n * max_cost_ + 1;
+    AddArc(size_, 1, bound, -price);
+    for (auto& edges : graph_) {
+      for (auto& edge : edges) {
+        edge.cost *= n;
+      }
+    }
+    potential_.assign(size_ + 1, 0);
+    excess_.assign(size_ + 1, 0);
+    arc_.assign(size_ + 1, 0);
+    int64_t eps = price * n;
+    do {
+      eps = std::max<int64_t>(1, eps / alpha);
+      Refine(eps);
+    } while (eps > 1);
+    for (auto& edges : graph_) {
+      for (auto& edge : edges) {
+        edge.cost /= n;
+      }
+    }
+    int64_t flow = graph_[size_].back().f;
+    graph_[size_].pop_back();
+    graph_[1].pop_back();
+    int64_t cost = 0;
+    for (int v = 1; v <= size_; ++v) {
+      for (auto& edge : graph_[v]) {
+        if (edge.f > 0) {
+          cost += edge.f * edge.cost;
+        }
+      }
+    }
+    return {flow, cost};
+  }
+};
+
+void Benchmark(int n, int m, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> vertex(1, n);
+  std::uniform_int_distribution<int> capacity(1, 1000);
+  std::uniform_int_distribution<int> cost(0, 1000);
+  Graph graph(n);
+  for (int i = 0; i < m; ++i) {
+    graph.AddEdge(vertex(gen), vertex(gen), capacity(gen), cost(gen));
+  }
+  Graph copy = graph;
+  auto t0 = std::chrono::steady_clock::now();
+  auto ssp = graph.SSP();
+  auto t1 = std::chrono::steady_clock::now();
+  auto scaling = copy.CostScaling();
+  auto t2 = std::chrono::steady_clock::now();
+  std::cout << "n=" << n << " m=" << m << '\n';
+  std::cout << "SSP:          " << ssp.first << ' ' << ssp.second << ' '
+            << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+  std::cout << "CostScaling:  " << scaling.first << ' ' << scaling.second << ' '
+            << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms\n";
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    int n = argc > 2 ? std::stoi(argv[2]) : 1'000;
+    int m = argc > 3 ? std::stoi(argv[3]) : 10'000;
+    Benchmark(n, m, argc > 4 ? std::stoi(argv[4]) : 1);
+    return 0;
+  }
+  std::ios::sync_with_stdio(false);
+  std::cin.tie(nullptr);
+  std::cout.tie(nullptr);
+  int n = 0;
+  int m = 0;
+  int v = 0;
+  int u = 0;
+  int64_t c = 0;
+  int64_t cost = 0;
+  std::cin >> n >> m;
+  Graph graph(n);
+  for (int i = 0; i < m; ++i) {
+    std::cin >> v >> u >> c >> cost;
+    graph.AddEdge(v, u, c, cost);
+  }
+  auto [flow, total] = graph.SSP();
+  std::cout << flow << ' ' << total << '\n';
+}
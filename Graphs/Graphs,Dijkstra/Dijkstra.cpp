@@ -1,93 +1,238 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
-class Heap {
-  int size_ = 0;
-  std::vector<std::pair<int, int>> heap_;
-  std::vector<int> map_;
+#include "../heap/bucket_queue.h"
+#include "../heap/heap.h"
+#include "../heap/radix_heap.h"
 
- public:
-  explicit Heap(int max_size) : heap_(max_size), map_(max_size, -1) {
-  }
-  int Parent(int i) {
-    return (i - 1) / 2;
-  }
-  int LeftChild(int i) {
-    return i * 2 + 1;
-  }
-  int RightChild(int i) {
-    return i * 2 + 2;
-  }
-  int SiftUp(int i) {
-    int parent = Parent(i);
-    if (i > 0 && heap_[parent].first > heap_[i].first) {
-      std::swap(heap_[parent], heap_[i]);
-      std::swap(map_[heap_[parent].second], map_[heap_[i].second]);
-      i = SiftUp(parent);
-    }
-    return i;
+enum class QueueKind { kAuto, kBinaryHeap, kRadixHeap, kDial };
+
+template <class F>
+void Parallel(int threads, F&& fn) {
+  std::vector<std::thread> workers;
+  for (int id = 1; id < threads; ++id) {
+    workers.emplace_back(fn, id);
   }
-  void Add(int x, int w) {
-    heap_[size_++].first = w;
-    heap_[size_ - 1].second = x;
-    map_[x] = size_ - 1;
-    SiftUp(size_ - 1);
+  fn(0);
+  for (auto& worker : workers) {
+    worker.join();
   }
-  int SiftDown(int i) {
-    int left = LeftChild(i);
-    int right = RightChild(i);
-    int largest = i;
-    if (left < size_ && heap_[left].first < heap_[largest].first) {
-      largest = left;
-    }
-    if (right < size_ && heap_[right].first < heap_[largest].first) {
-      largest = right;
+}
+
+struct Workspace {
+  std::vector<int> dist;
+  std::vector<int> prev;
+  BucketQueue dial{0};
+  RadixHeap radix;
+};
+
+struct ShortestPathTree {
+  int root = -1;
+  std::vector<int> dist;
+  std::vector<int> parent;
+  std::vector<int> edge;
+
+  std::vector<int> Path(int v) const {
+    std::vector<int> path;
+    if (parent[v] == -1 && v != root) {
+      return path;
     }
-    if (largest != i) {
-      std::swap(heap_[largest], heap_[i]);
-      std::swap(map_[heap_[largest].second], map_[heap_[i].second]);
-      i = SiftDown(largest);
+    for (; v != -1; v = parent[v]) {
+      path.push_back(v);
     }
-    return i;
+    std::reverse(path.begin(), path.end());
+    return path;
   }
-  std::pair<int, int> ExtractMin() {
-    if (size_ > 1) {
-      auto val = heap_[0];
-      --size_;
-      std::swap(heap_[0], heap_[size_]);
-      std::swap(map_[heap_[0].second], map_[heap_[size_].second]);
-      SiftDown(0);
-      return val;
+  std::vector<int> PathEdges(int v) const {
+    std::vector<int> path;
+    if (edge.empty()) {
+      return path;
+    }
+    for (; parent[v] != -1; v = parent[v]) {
+      path.push_back(edge[v]);
     }
-    --size_;
-    return heap_[0];
+    std::reverse(path.begin(), path.end());
+    return path;
   }
-  void DecreaseKey(int x, int new_w) {
-    int i = map_[x];
-    heap_[i].first = new_w;
-    SiftUp(i);
+  void Write(std::ostream& out) const {
+    int32_t n = static_cast<int32_t>(dist.size());
+    std::vector<int32_t> buffer;
+    buffer.reserve(3 + 3 * static_cast<size_t>(n));
+    buffer.push_back(n);
+    buffer.push_back(root);
+    buffer.push_back(edge.empty() ? 0 : 1);
+    buffer.insert(buffer.end(), dist.begin(), dist.end());
+    buffer.insert(buffer.end(), parent.begin(), parent.end());
+    buffer.insert(buffer.end(), edge.begin(), edge.end());
+    out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(int32_t));
   }
-  bool Empty() {
-    return size_ == 0;
+};
+
+class Barrier {
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  int threads_;
+  std::atomic<int> waiting_{0};
+  std::atomic<int64_t> generation_{0};
+
+ public:
+  explicit Barrier(int threads) : threads_(threads) {
   }
-  bool Contains(int i) {
-    return map_[i] < size_;
+  void Wait() {
+    int64_t generation = generation_.load();
+    if (waiting_.fetch_add(1) + 1 == threads_) {
+      waiting_.store(0);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.fetch_add(1);
+      }
+      cv_.notify_all();
+      return;
+    }
+    for (int spin = 0; spin < 64; ++spin) {
+      if (generation_.load() != generation) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] { return generation_.load() != generation; });
   }
 };
 
 class Graph {
   std::vector<std::vector<std::pair<int, int>>> graph_;
+  std::vector<std::vector<int>> ids_;
   int max_weight_ = 0;
+  int64_t arcs_ = 0;
+  std::vector<int> dist_;
+  std::vector<int> origin_;
+  std::vector<uint32_t> seen_;
+  std::vector<uint32_t> done_;
+  std::vector<uint32_t> target_;
+  uint32_t epoch_ = 0;
+  BucketQueue dial_{0};
+  RadixHeap radix_;
+
+  void Begin() {
+    if (seen_.size() != graph_.size()) {
+      dist_.resize(graph_.size());
+      origin_.resize(graph_.size());
+      seen_.assign(graph_.size(), 0);
+      done_.assign(graph_.size(), 0);
+      target_.assign(graph_.size(), 0);
+      epoch_ = 0;
+    }
+    if (++epoch_ == 0) {
+      std::fill(seen_.begin(), seen_.end(), 0);
+      std::fill(done_.begin(), done_.end(), 0);
+      std::fill(target_.begin(), target_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+  void Touch(int v) {
+    if (seen_[v] != epoch_) {
+      seen_[v] = epoch_;
+      dist_[v] = 2009000999;
+      origin_[v] = -1;
+    }
+  }
+  template <class Queue>
+  void Search(Queue& queue, const std::vector<int>& sources, int targets) {
+    for (auto s : sources) {
+      Touch(s);
+      if (dist_[s] != 0) {
+        dist_[s] = 0;
+        origin_[s] = s;
+        queue.Push(0, s);
+      }
+    }
+    while (!queue.Empty()) {
+      int v = queue.Pop().second;
+      if (done_[v] == epoch_) {
+        continue;
+      }
+      done_[v] = epoch_;
+      if (target_[v] == epoch_ && --targets == 0) {
+        break;
+      }
+      for (auto [w, u] : graph_[v]) {
+        Touch(u);
+        if (w + dist_[v] < dist_[u]) {
+          dist_[u] = w + dist_[v];
+          origin_[u] = origin_[v];
+          queue.Push(dist_[u], u);
+        }
+      }
+    }
+    queue.Clear();
+  }
+  void Run(const std::vector<int>& sources, int targets) {
+    if (max_weight_ < 4096) {
+      dial_.Reserve(max_weight_);
+      Search(dial_, sources, targets);
+    } else {
+      radix_.Clear();
+      Search(radix_, sources, targets);
+    }
+  }
 
  public:
-  explicit Graph(int n) : graph_(n) {
+  explicit Graph(int n) : graph_(n), ids_(n) {
   }
   void AddEdge(int start, int finish, int weight) {
     if (weight > max_weight_) {
       max_weight_ = weight;
     }
+    int id = static_cast<int>(arcs_ / 2);
     graph_[start].emplace_back(weight, finish);
     graph_[finish].emplace_back(weight, start);
+    ids_[start].push_back(id);
+    ids_[finish].push_back(id);
+    arcs_ += 2;
+  }
+  size_t Size() const {
+    return graph_.size();
+  }
+  const std::vector<std::pair<int, int>>& Neighbours(int v) const {
+    return graph_[v];
+  }
+  const std::vector<int>& EdgeIds(int v) const {
+    return ids_[v];
+  }
+  std::pair<int, int> SetWeight(int start, int finish, int weight) {
+    int id = -1;
+    int old = 2009000999;
+    for (size_t i = 0; i < graph_[start].size() && id == -1; ++i) {
+      if (graph_[start][i].second == finish) {
+        id = ids_[start][i];
+        old = graph_[start][i].first;
+      }
+    }
+    if (id == -1) {
+      id = static_cast<int>(arcs_ / 2);
+      AddEdge(start, finish, weight);
+      return {id, old};
+    }
+    max_weight_ = std::max(max_weight_, weight);
+    for (int v : {start, finish}) {
+      for (size_t i = 0; i < graph_[v].size(); ++i) {
+        if (ids_[v][i] == id) {
+          graph_[v][i].first = weight;
+        }
+      }
+    }
+    return {id, old};
   }
   void BFS(int s, std::vector<bool>& visited, std::vector<int>& comp) {
     visited[s] = true;
@@ -104,13 +249,215 @@ class Graph {
     BFS(s, visited, comp);
     return comp;
   }
-  std::vector<int> Dijkstra(int start) {
+  template <class Queue>
+  void MonotoneDijkstra(int start, Queue& queue, std::vector<int>& dist, std::vector<int>& prev,
+                        std::vector<int>* edge = nullptr) {
+    int inf = 2009000999;
+    dist.assign(graph_.size(), inf);
+    prev.assign(graph_.size(), -1);
+    if (edge != nullptr) {
+      edge->assign(graph_.size(), -1);
+    }
+    dist[start] = 0;
+    queue.Push(0, start);
+    while (!queue.Empty()) {
+      auto [d, v] = queue.Pop();
+      if (static_cast<int>(d) != dist[v]) {
+        continue;
+      }
+      for (size_t i = 0; i < graph_[v].size(); ++i) {
+        auto [w, u] = graph_[v][i];
+        if (w + dist[v] < dist[u]) {
+          prev[u] = v;
+          dist[u] = w + dist[v];
+          if (edge != nullptr) {
+            (*edge)[u] = ids_[v][i];
+          }
+          queue.Push(dist[u], u);
+        }
+      }
+    }
+  }
+  template <class Queue>
+  std::vector<int> MonotoneDijkstra(int start, Queue& queue) {
+    std::vector<int> dist;
+    std::vector<int> prev;
+    MonotoneDijkstra(start, queue, dist, prev);
+    return dist;
+  }
+  std::vector<int> Dijkstra(int start, QueueKind kind = QueueKind::kAuto) {
+    if (kind == QueueKind::kAuto) {
+      kind = max_weight_ < 4096 ? QueueKind::kDial : QueueKind::kRadixHeap;
+    }
+    if (kind == QueueKind::kDial) {
+      BucketQueue queue(max_weight_);
+      return MonotoneDijkstra(start, queue);
+    }
+    if (kind == QueueKind::kRadixHeap) {
+      RadixHeap queue;
+      return MonotoneDijkstra(start, queue);
+    }
+    return HeapDijkstra(start);
+  }
+  const std::vector<int>& Dijkstra(int start, Workspace& workspace) {
+    if (max_weight_ < 4096) {
+      workspace.dial.Reserve(max_weight_);
+      MonotoneDijkstra(start, workspace.dial, workspace.dist, workspace.prev);
+    } else {
+      workspace.radix.Clear();
+      MonotoneDijkstra(start, workspace.radix, workspace.dist, workspace.prev);
+    }
+    return workspace.dist;
+  }
+  ShortestPathTree Tree(int start, bool edges = false) {
+    ShortestPathTree tree;
+    tree.root = start;
+    auto* edge = edges ? &tree.edge : nullptr;
+    if (max_weight_ < 4096) {
+      BucketQueue queue(max_weight_);
+      MonotoneDijkstra(start, queue, tree.dist, tree.parent, edge);
+    } else {
+      RadixHeap queue;
+      MonotoneDijkstra(start, queue, tree.dist, tree.parent, edge);
+    }
+    return tree;
+  }
+  void DijkstraMultiSource(const std::vector<int>& sources) {
+    Begin();
+    Run(sources, -1);
+  }
+  std::vector<int> DijkstraToTargets(int start, const std::vector<int>& targets) {
+    Begin();
+    int count = 0;
+    for (auto t : targets) {
+      if (target_[t] != epoch_) {
+        target_[t] = epoch_;
+        ++count;
+      }
+    }
+    if (count > 0) {
+      Run({start}, count);
+    }
+    std::vector<int> dist;
+    dist.reserve(targets.size());
+    for (auto t : targets) {
+      dist.push_back(Distance(t));
+    }
+    return dist;
+  }
+  int Distance(int v) const {
+    return done_[v] == epoch_ ? dist_[v] : 2009000999;
+  }
+  int Nearest(int v) const {
+    return done_[v] == epoch_ ? origin_[v] : -1;
+  }
+  int Delta() const {
+    int64_t degree = graph_.empty() ? 1 : std::max<int64_t>(1, arcs_ / static_cast<int64_t>(graph_.size()));
+    return std::max<int>(1, static_cast<int>(max_weight_ / degree));
+  }
+  std::vector<int> DeltaStepping(int start, int threads = 0, int delta = 0) {
+    int inf = 2009000999;
+    int n = static_cast<int>(graph_.size());
+    if (threads <= 0) {
+      threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    if (delta <= 0) {
+      delta = Delta();
+    }
+    int slots = max_weight_ / delta + 2;
+    std::vector<int> dist(n, inf);
+    std::vector<int> round(n, -1);
+    std::vector<int64_t> settled_in(n, -1);
+    std::vector<std::vector<std::vector<int>>> buckets(threads, std::vector<std::vector<int>>(slots));
+    std::vector<std::vector<std::vector<std::pair<int, int>>>> requests(
+        threads, std::vector<std::vector<std::pair<int, int>>>(threads));
+    std::vector<size_t> sizes(threads);
+    std::vector<int64_t> next(threads);
+    Barrier barrier(threads);
+    dist[start] = 0;
+    buckets[start % threads][0].push_back(start);
+    Parallel(threads, [&](int id) {
+      auto relax = [&](const std::vector<int>& vertices, bool light) {
+        for (auto v : vertices) {
+          for (auto [w, u] : graph_[v]) {
+            if ((w <= delta) == light) {
+              requests[id][u % threads].emplace_back(u, dist[v] + w);
+            }
+          }
+        }
+        barrier.Wait();
+        for (int from = 0; from < threads; ++from) {
+          for (auto [u, d] : requests[from][id]) {
+            if (d < dist[u]) {
+              dist[u] = d;
+              buckets[id][(d / delta) % slots].push_back(u);
+            }
+          }
+          requests[from][id].clear();
+        }
+        barrier.Wait();
+      };
+      std::vector<int> frontier;
+      std::vector<int> settled;
+      int rounds = 0;
+      int64_t current = 0;
+      while (true) {
+        auto& bucket = buckets[id][current % slots];
+        settled.clear();
+        bool any = false;
+        while (true) {
+          frontier.clear();
+          for (auto v : bucket) {
+            if (dist[v] / delta == current && round[v] != rounds) {
+              round[v] = rounds;
+              frontier.push_back(v);
+              if (settled_in[v] != current) {
+                settled_in[v] = current;
+                settled.push_back(v);
+              }
+            }
+          }
+          bucket.clear();
+          sizes[id] = frontier.size();
+          barrier.Wait();
+          size_t total = 0;
+          for (auto size : sizes) {
+            total += size;
+          }
+          if (total == 0) {
+            break;
+          }
+          any = true;
+          ++rounds;
+          relax(frontier, true);
+        }
+        if (any) {
+          relax(settled, false);
+        }
+        next[id] = slots;
+        for (int64_t k = 1; k < slots; ++k) {
+          if (!buckets[id][(current + k) % slots].empty()) {
+            next[id] = k;
+            break;
+          }
+        }
+        barrier.Wait();
+        int64_t step = *std::min_element(next.begin(), next.end());
+        if (step == slots) {
+          break;
+        }
+        current += step;
+      }
+    });
+    return dist;
+  }
+  std::vector<int> HeapDijkstra(int start) {
     int inf = 2009000999;
     std::vector<int> dist(graph_.size(), inf);
     dist[start] = 0;
     auto comp = Comp(start);
     std::vector<int> prev(graph_.size(), -1);
-    Heap heap(static_cast<int>(graph_.size()));
+    Heap<int> heap(static_cast<int>(graph_.size()));
     for (auto i : comp) {
       heap.Add(i, dist[i]);
     }
@@ -129,7 +476,208 @@ class Graph {
   }
 };
 
-int main() {
+class DynamicShortestPaths {
+  Graph& graph_;
+  ShortestPathTree tree_;
+  Heap<int> heap_;
+  std::vector<uint32_t> mark_;
+  std::vector<int> affected_;
+  uint32_t epoch_ = 0;
+  int inf_ = 2009000999;
+
+  void Improve(int u, int d, int parent, int edge) {
+    tree_.dist[u] = d;
+    tree_.parent[u] = parent;
+    tree_.edge[u] = edge;
+    if (heap_.Contains(u)) {
+      heap_.DecreaseKey(u, d);
+    } else {
+      heap_.Add(u, d);
+    }
+  }
+  void Propagate() {
+    while (!heap_.Empty()) {
+      int v = heap_.ExtractMin().second;
+      const auto& edges = graph_.Neighbours(v);
+      for (size_t i = 0; i < edges.size(); ++i) {
+        auto [w, u] = edges[i];
+        if (tree_.dist[v] + w < tree_.dist[u]) {
+          Improve(u, tree_.dist[v] + w, v, graph_.EdgeIds(v)[i]);
+        }
+      }
+    }
+  }
+  void Detach(int root) {
+    if (++epoch_ == 0) {
+      std::fill(mark_.begin(), mark_.end(), 0);
+      epoch_ = 1;
+    }
+    affected_.assign(1, root);
+    mark_[root] = epoch_;
+    for (size_t k = 0; k < affected_.size(); ++k) {
+      int v = affected_[k];
+      const auto& edges = graph_.Neighbours(v);
+      for (size_t i = 0; i < edges.size(); ++i) {
+        int u = edges[i].second;
+        if (mark_[u] != epoch_ && tree_.parent[u] == v && tree_.edge[u] == graph_.EdgeIds(v)[i]) {
+          mark_[u] = epoch_;
+          affected_.push_back(u);
+        }
+      }
+    }
+    for (auto v : affected_) {
+      tree_.dist[v] = inf_;
+      tree_.parent[v] = -1;
+      tree_.edge[v] = -1;
+    }
+    for (auto v : affected_) {
+      const auto& edges = graph_.Neighbours(v);
+      for (size_t i = 0; i < edges.size(); ++i) {
+        auto [w, u] = edges[i];
+        if (mark_[u] != epoch_ && tree_.dist[u] != inf_ && tree_.dist[u] + w < tree_.dist[v]) {
+          tree_.dist[v] = tree_.dist[u] + w;
+          tree_.parent[v] = u;
+          tree_.edge[v] = graph_.EdgeIds(v)[i];
+        }
+      }
+      if (tree_.dist[v] != inf_) {
+        heap_.Add(v, tree_.dist[v]);
+      }
+    }
+  }
+
+ public:
+  DynamicShortestPaths(Graph& graph, int start)
+      : graph_(graph),
+        tree_(graph.Tree(start, true)),
+        heap_(static_cast<int>(graph.Size())),
+        mark_(graph.Size(), 0) {
+  }
+  void UpdateEdge(int v, int u, int w) {
+    auto [id, old] = graph_.SetWeight(v, u, w);
+    affected_.clear();
+    if (w < old) {
+      for (auto [a, b] : {std::make_pair(v, u), std::make_pair(u, v)}) {
+        if (tree_.dist[a] != inf_ && tree_.dist[a] + w < tree_.dist[b]) {
+          Improve(b, tree_.dist[a] + w, a, id);
+        }
+      }
+    } else if (w > old) {
+      if (tree_.parent[u] == v && tree_.edge[u] == id) {
+        Detach(u);
+      } else if (tree_.parent[v] == u && tree_.edge[v] == id) {
+        Detach(v);
+      }
+    }
+    Propagate();
+  }
+  size_t Affected() const {
+    return affected_.size();
+  }
+  int Distance(int v) const {
+    return tree_.dist[v];
+  }
+  const ShortestPathTree& Tree() const {
+    return tree_;
+  }
+};
+
+void DynamicBenchmark(int n, int updates, unsigned seed) {
+  std::mt19937 rng(seed);
+  int m = 4 * n;
+  Graph graph(n);
+  std::vector<std::pair<int, int>> edges;
+  for (int v = 1; v < n; ++v) {
+    edges.emplace_back(static_cast<int>(rng() % v), v);
+  }
+  while (static_cast<int>(edges.size()) < m) {
+    edges.emplace_back(static_cast<int>(rng() % n), static_cast<int>(rng() % n));
+  }
+  for (auto [s, f] : edges) {
+    graph.AddEdge(s, f, static_cast<int>(rng() % 1000 + 1));
+  }
+  DynamicShortestPaths dynamic(graph, 0);
+  std::vector<std::tuple<int, int, int>> batch(updates);
+  for (auto& [s, f, w] : batch) {
+    auto edge = edges[rng() % edges.size()];
+    s = edge.first;
+    f = edge.second;
+    w = static_cast<int>(rng() % 1000 + 1);
+  }
+  size_t affected = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (auto [s, f, w] : batch) {
+    dynamic.UpdateEdge(s, f, w);
+    affected += dynamic.Affected();
+  }
+  auto middle = std::chrono::steady_clock::now();
+  std::vector<int> dist;
+  for (int i = 0; i < std::min(updates, 100); ++i) {
+    dist = graph.Dijkstra(0);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double incremental = std::chrono::duration<double, std::micro>(middle - begin).count() / std::max(1, updates);
+  double full = std::chrono::duration<double, std::micro>(end - middle).count() / std::max(1, std::min(updates, 100));
+  bool same = dist == dynamic.Tree().dist;
+  std::cout << "n = " << n << ", m = " << m << ", updates = " << updates << '\n';
+  std::cout << "update_us " << incremental << ", recompute_us " << full << ", speedup " << full / incremental << '\n';
+  std::cout << "detached per update " << static_cast<double>(affected) / std::max(1, updates) << '\n';
+  std::cout << (same ? "distances match" : "distances differ") << '\n';
+}
+
+void Batch(int threads) {
+  int n = 0;
+  int m = 0;
+  int k = 0;
+  int s = 0;
+  int f = 0;
+  int w = 0;
+  std::cin >> k;
+  std::vector<Graph> graphs;
+  std::vector<int> starts(k);
+  graphs.reserve(k);
+  for (int i = 0; i < k; ++i) {
+    std::cin >> n >> m;
+    graphs.emplace_back(n);
+    for (int j = 0; j < m; ++j) {
+      std::cin >> s >> f >> w;
+      graphs.back().AddEdge(s, f, w);
+    }
+    std::cin >> starts[i];
+  }
+  if (threads <= 0) {
+    threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  threads = std::max(1, std::min(threads, k));
+  std::vector<std::string> output(k);
+  std::atomic<int> next{0};
+  Parallel(threads, [&](int) {
+    Workspace workspace;
+    for (int i = next++; i < k; i = next++) {
+      for (auto d : graphs[i].Dijkstra(starts[i], workspace)) {
+        output[i] += std::to_string(d);
+        output[i] += ' ';
+      }
+      output[i] += '\n';
+      graphs[i] = Graph(0);
+    }
+  });
+  for (auto& line : output) {
+    std::cout << line;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "batch") {
+    Batch(argc > 2 ? std::stoi(argv[2]) : 0);
+    return 0;
+  }
+  if (mode == "dynamic-bench") {
+    DynamicBenchmark(argc > 2 ? std::stoi(argv[2]) : 100000, argc > 3 ? std::stoi(argv[3]) : 10000,
+                     argc > 4 ? std::stoi(argv[4]) : 2009);
+    return 0;
+  }
   int n = 0;
   int m = 0;
   int k = 0;
@@ -145,7 +693,62 @@ int main() {
       graph.AddEdge(s, f, w);
     }
     std::cin >> n;
-    auto dist = graph.Dijkstra(n);
+    if (mode == "multi-source") {
+      std::vector<int> sources(n);
+      for (auto& source : sources) {
+        std::cin >> source;
+      }
+      graph.DijkstraMultiSource(sources);
+      for (int v = 0; v < static_cast<int>(graph.Size()); ++v) {
+        std::cout << graph.Distance(v) << ' ';
+      }
+      std::cout << '\n';
+      continue;
+    }
+    if (mode == "dynamic") {
+      DynamicShortestPaths dynamic(graph, n);
+      std::cin >> m;
+      for (int j = 0; j < m; ++j) {
+        std::cin >> s >> f >> w;
+        dynamic.UpdateEdge(s, f, w);
+      }
+      for (auto d : dynamic.Tree().dist) {
+        std::cout << d << ' ';
+      }
+      std::cout << '\n';
+      continue;
+    }
+    if (mode == "tree") {
+      graph.Tree(n, argc > 2 && std::string(argv[2]) == "edges").Write(std::cout);
+      continue;
+    }
+    if (mode == "paths") {
+      auto tree = graph.Tree(n);
+      std::cin >> m;
+      for (int j = 0; j < m; ++j) {
+        std::cin >> f;
+        auto path = tree.Path(f);
+        std::cout << (path.empty() ? -1 : tree.dist[f]);
+        for (auto v : path) {
+          std::cout << ' ' << v;
+        }
+        std::cout << '\n';
+      }
+      continue;
+    }
+    if (mode == "targets") {
+      std::cin >> m;
+      std::vector<int> targets(m);
+      for (auto& target : targets) {
+        std::cin >> target;
+      }
+      for (auto d : graph.DijkstraToTargets(n, targets)) {
+        std::cout << d << ' ';
+      }
+      std::cout << '\n';
+      continue;
+    }
+    auto dist = mode == "delta-stepping" ? graph.DeltaStepping(n) : graph.Dijkstra(n);
     for (auto d : dist) {
       std::cout << d << ' ';
     }
@@ -0,0 +1,48 @@
+#ifndef BUCKET_QUEUE
+#define BUCKET_QUEUE
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class BucketQueue {
+  std::vector<std::vector<int>> buckets_;
+  uint32_t cur_ = 0;
+  int size_ = 0;
+
+ public:
+  explicit BucketQueue(int max_weight) : buckets_(max_weight + 1) {
+  }
+  void Push(uint32_t key, int id) {
+    buckets_[key % buckets_.size()].push_back(id);
+    ++size_;
+  }
+  std::pair<uint32_t, int> Pop() {
+    while (buckets_[cur_ % buckets_.size()].empty()) {
+      ++cur_;
+    }
+    auto& bucket = buckets_[cur_ % buckets_.size()];
+    int id = bucket.back();
+    bucket.pop_back();
+    --size_;
+    return {cur_, id};
+  }
+  bool Empty() const {
+    return size_ == 0;
+  }
+  void Reserve(int max_weight) {
+    Clear();
+    if (buckets_.size() < static_cast<size_t>(max_weight) + 1) {
+      buckets_.resize(max_weight + 1);
+    }
+  }
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    cur_ = 0;
+    size_ = 0;
+  }
+};
+
+#endif  // BUCKET_QUEUE
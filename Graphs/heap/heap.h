@@ -0,0 +1,103 @@
+#ifndef HEAP
+#define HEAP
+
+#include <utility>
+#include <vector>
+
+template <class Key, int Arity = 2>
+class Heap {
+  static_assert(Arity >= 2, "heap arity must be at least 2");
+
+  int size_ = 0;
+  std::vector<Key> keys_;
+  std::vector<int> ids_;
+  std::vector<int> map_;
+
+  void Place(int i, const Key& key, int id) {
+    keys_[i] = key;
+    ids_[i] = id;
+    map_[id] = i;
+  }
+  int SiftUp(int i) {
+    Key key = keys_[i];
+    int id = ids_[i];
+    while (i > 0) {
+      int parent = (i - 1) / Arity;
+      if (!(key < keys_[parent])) {
+        break;
+      }
+      Place(i, keys_[parent], ids_[parent]);
+      i = parent;
+    }
+    Place(i, key, id);
+    return i;
+  }
+  int SiftDown(int i) {
+    Key key = keys_[i];
+    int id = ids_[i];
+    while (true) {
+      int first = i * Arity + 1;
+      if (first >= size_) {
+        break;
+      }
+      int last = first + Arity < size_ ? first + Arity : size_;
+      int smallest = first;
+      for (int child = first + 1; child < last; ++child) {
+        if (keys_[child] < keys_[smallest]) {
+          smallest = child;
+        }
+      }
+      if (!(keys_[smallest] < key)) {
+        break;
+      }
+      Place(i, keys_[smallest], ids_[smallest]);
+      i = smallest;
+    }
+    Place(i, key, id);
+    return i;
+  }
+
+ public:
+  explicit Heap(int max_size) : keys_(max_size), ids_(max_size), map_(max_size, -1) {
+  }
+  void Add(int x, const Key& w) {
+    keys_[size_] = w;
+    ids_[size_] = x;
+    map_[x] = size_;
+    SiftUp(size_++);
+  }
+  std::pair<Key, int> ExtractMin() {
+    std::pair<Key, int> min(keys_[0], ids_[0]);
+    map_[ids_[0]] = -1;
+    if (--size_ > 0) {
+      Place(0, keys_[size_], ids_[size_]);
+      SiftDown(0);
+    }
+    return min;
+  }
+  void DecreaseKey(int x, const Key& new_w) {
+    int i = map_[x];
+    keys_[i] = new_w;
+    SiftUp(i);
+  }
+  const Key& MinKey() const {
+    return keys_[0];
+  }
+  bool Empty() const {
+    return size_ == 0;
+  }
+  int Size() const {
+    return size_;
+  }
+  bool Contains(int x) const {
+    return map_[x] != -1;
+  }
+  void Clear() {
+    for (int i = 0; i < size_; ++i) {
+      map_[ids_[i]] = -1;
+    }
+    size_ = 0;
+  }
+};
+
+#endif  // HEAP
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "heap.h"
+
+struct Grid {
+  int side = 0;
+  std::vector<std::vector<std::pair<int, int>>> graph;
+};
+
+Grid MakeGrid(int side, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> weight(1, 1000);
+  Grid grid;
+  grid.side = side;
+  grid.graph.resize(side * side);
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      int v = r * side + c;
+      if (c + 1 < side) {
+        int w = weight(gen);
+        grid.graph[v].emplace_back(w, v + 1);
+        grid.graph[v + 1].emplace_back(w, v);
+      }
+      if (r + 1 < side) {
+        int w = weight(gen);
+        grid.graph[v].emplace_back(w, v + side);
+        grid.graph[v + side].emplace_back(w, v);
+      }
+    }
+  }
+  return grid;
+}
+
+template <int Arity>
+int64_t GridDijkstra(const Grid& grid) {
+  int n = static_cast<int>(grid.graph.size());
+  int inf = 2009000999;
+  std::vector<int> dist(n, inf);
+  Heap<int, Arity> heap(n);
+  dist[0] = 0;
+  heap.Add(0, 0);
+  int64_t checksum = 0;
+  while (!heap.Empty()) {
+    auto [d, v] = heap.ExtractMin();
+    checksum += d;
+    for (auto [w, u] : grid.graph[v]) {
+      if (d + w < dist[u]) {
+        if (dist[u] == inf) {
+          heap.Add(u, d + w);
+        } else {
+          heap.DecreaseKey(u, d + w);
+        }
+        dist[u] = d + w;
+      }
+    }
+  }
+  return checksum;
+}
+
+template <int Arity>
+int64_t DecreaseKeyStorm(int n, int updates, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> id(0, n - 1);
+  std::vector<int> key(n);
+  Heap<int, Arity> heap(n);
+  for (int i = 0; i < n; ++i) {
+    key[i] = 1'000'000'000 - static_cast<int>(gen() % 1'000'000);
+    heap.Add(i, key[i]);
+  }
+  for (int i = 0; i < updates; ++i) {
+    int x = id(gen);
+    key[x] -= static_cast<int>(gen() % 1000) + 1;
+    heap.DecreaseKey(x, key[x]);
+  }
+  int64_t checksum = 0;
+  while (!heap.Empty()) {
+    checksum += heap.ExtractMin().first;
+  }
+  return checksum;
+}
+
+template <int Arity>
+void Run(const Grid& grid, int n, int updates) {
+  auto t0 = std::chrono::steady_clock::now();
+  int64_t a = GridDijkstra<Arity>(grid);
+  auto t1 = std::chrono::steady_clock::now();
+  int64_t b = DecreaseKeyStorm<Arity>(n, updates, 1);
+  auto t2 = std::chrono::steady_clock::now();
+  std::cout << Arity << "-ary  grid: " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+            << " ms (" << a << ")  decrease-key: "
+            << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms (" << b << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+  int side = argc > 1 ? std::stoi(argv[1]) : 1'000;
+  int n = argc > 2 ? std::stoi(argv[2]) : 1'000'000;
+  int updates = argc > 3 ? std::stoi(argv[3]) : 10'000'000;
+  auto grid = MakeGrid(side, 1);
+  Run<2>(grid, n, updates);
+  Run<4>(grid, n, updates);
+  Run<8>(grid, n, updates);
+  return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef RADIX_HEAP
+#define RADIX_HEAP
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+class RadixHeap {
+  std::vector<std::vector<std::pair<uint32_t, int>>> buckets_;
+  uint32_t last_ = 0;
+  int size_ = 0;
+
+  static int Bucket(uint32_t key, uint32_t last) {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+  }
+
+ public:
+  RadixHeap() : buckets_(33) {
+  }
+  void Push(uint32_t key, int id) {
+    buckets_[Bucket(key, last_)].emplace_back(key, id);
+    ++size_;
+  }
+  std::pair<uint32_t, int> Pop() {
+    if (buckets_[0].empty()) {
+      size_t i = 1;
+      while (buckets_[i].empty()) {
+        ++i;
+      }
+      uint32_t min = std::numeric_limits<uint32_t>::max();
+      for (auto& item : buckets_[i]) {
+        if (item.first < min) {
+          min = item.first;
+        }
+      }
+      last_ = min;
+      for (auto& item : buckets_[i]) {
+        buckets_[Bucket(item.first, last_)].push_back(item);
+      }
+      buckets_[i].clear();
+    }
+    auto item = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return item;
+  }
+  bool Empty() const {
+    return size_ == 0;
+  }
+  void Clear() {
+    for (auto& bucket : buckets_) {
+      bucket.clear();
+    }
+    last_ = 0;
+    size_ = 0;
+  }
+};
+
+#endif  // RADIX_HEAP